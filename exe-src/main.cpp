@@ -3,14 +3,24 @@
 #include "../lib-src/Printer.h"
 #include "../lib-src/Map.h"
 #include "../lib-src/PP.h"
+#include "../lib-src/PBS.h"
+#include "../lib-src/PIBT.h"
+#include "../lib-src/Portfolio.h"
 #include "../lib-src/FullPlanner.h"
 #include "../lib-src/SIPP.h"
 #include "../lib-src/EES-SIPP.h"
+#include "../lib-src/Focal-SIPP.h"
+#include "../lib-src/Incremental-SIPP.h"
 #include "../lib-src/CBS.h"
+#include "../lib-src/ECBS.h"
+#include "../lib-src/LNS.h"
+#include "../lib-src/MA-CBS.h"
+#include "../lib-src/ParallelCBS.h"
 #include "../lib-src/FullIDPlanner.h"
 #include "../lib-src/Scenario.h"
 #include <cstdlib>
 #include <string>
+#include <thread>
 
 IPlanner* CreatePlanner(const std::string& framework_name, const std::string& high_level_planner_name, const std::string& low_level_planner_name, const std::string& policy_name);
 IPlanner* CreateFramework(const std::string& framework_name, IHighLevelPlanner* high_level_planner, IPolicy* policy);
@@ -61,7 +71,7 @@ int main(int argc, const char* argv[])
 
     Print(Default, "Planner: ", planner->GetName(), '\n', "Map: ", m.GetName(), '\n', "Scenario: ", s.ToString(), '\n', "IsLegal: ", (is_legal_plan ? "True" : "False"), '\n',  "K: ", number_of_agents, \
     '\n', "|Eo?|: ", snap.GetNumberOfMaybeOpenEdge(), '\n', "|Eb?|: ", snap.GetNumberOfMaybeBlockedEdge(), '\n', \
-    "SOC: ", solution_cost, '\n', "#Replans: ", replans, '\n', "#Expansions: ", nexpansions, '\n', "Runtime: ", runtime, '\n', '\n');
+    "SOC: ", solution_cost, '\n', "#Replans: ", replans, '\n', "#Expansions: ", nexpansions, '\n', "Runtime: ", runtime, '\n', planner->GetStats(), '\n');
 
     if(is_planning_succeed && is_legal_plan && visualize_path)
     {
@@ -116,7 +126,20 @@ IHighLevelPlanner* CreateHighLevelPlanner(const std::string& high_level_planner_
 {
     std::unordered_map<std::string, std::function<IHighLevelPlanner*(ILowLevelPlanner* low_level_planner)>> highLevelPlannerMap = {
         {"pp", [](ILowLevelPlanner* low_level_planner) {return new PP(low_level_planner);}},
-        {"cbs", [](ILowLevelPlanner* low_level_planner) {return new CBS(low_level_planner);}}
+        {"pp_speculative", [](ILowLevelPlanner* low_level_planner) {return new PP(low_level_planner, 1, std::max(2u, std::thread::hardware_concurrency()));}},
+        {"cbs", [](ILowLevelPlanner* low_level_planner) {return new CBS(low_level_planner);}},
+        {"cbs_cg", [](ILowLevelPlanner* low_level_planner) {return new CBS(low_level_planner, CBS::Heuristic::CG);}},
+        {"cbs_dg", [](ILowLevelPlanner* low_level_planner) {return new CBS(low_level_planner, CBS::Heuristic::DG);}},
+        {"cbs_wdg", [](ILowLevelPlanner* low_level_planner) {return new CBS(low_level_planner, CBS::Heuristic::WDG);}},
+        {"ecbs", [](ILowLevelPlanner* low_level_planner) {return new ECBS(low_level_planner);}},
+        {"ma_cbs", [](ILowLevelPlanner* low_level_planner) {return new MACBS(low_level_planner, 10);}},
+        {"ma_cbs_restart", [](ILowLevelPlanner* low_level_planner) {return new MACBS(low_level_planner, 10, true);}},
+        {"lns", [](ILowLevelPlanner* low_level_planner) {return new LNS(low_level_planner);}},
+        {"pbs", [](ILowLevelPlanner* low_level_planner) {return new PBS(low_level_planner);}},
+        {"pibt", [](ILowLevelPlanner* low_level_planner) {delete low_level_planner; return new PIBT();}},
+        {"pibt_greedy", [](ILowLevelPlanner* low_level_planner) {delete low_level_planner; return new PIBT(false);}},
+        {"parallel_cbs", [](ILowLevelPlanner* low_level_planner) {return new ParallelCBS(low_level_planner, std::thread::hardware_concurrency());}},
+        {"portfolio", [](ILowLevelPlanner* low_level_planner) {return new Portfolio({new CBS(low_level_planner), new PP(low_level_planner->Clone()), new LNS(low_level_planner->Clone())});}}
     };
 
     auto it = highLevelPlannerMap.find(high_level_planner_name);
@@ -134,7 +157,9 @@ ILowLevelPlanner* CreateLowLevelPlanner(const std::string& low_level_planner_nam
 {
     std::unordered_map<std::string, std::function<ILowLevelPlanner*(void)>> lowLevelPlannerMap = {
         {"sipp", [](){return new SIPP();}},
-        {"ees_sipp", [](){return new EESSIPP();}}
+        {"ees_sipp", [](){return new EESSIPP();}},
+        {"focal_sipp", [](){return new FocalSIPP(1.2);}},
+        {"incremental_sipp", [](){return new IncrementalSIPP();}}
     };
 
     auto it = lowLevelPlannerMap.find(low_level_planner_name);
@@ -1,27 +1,49 @@
 #include "CBS.h"
 #include "Agent.h"
+#include "DependencyGraph.h"
+#include "Edge.h"
 #include "IConflict.h"
 #include "SafeIntervals.h"
+#include "SymmetryReasoning.h"
 #include "Timer.h"
 #include "Printer.h"
 #include "ILowLevelPlanner.h"
 #include "Types.h"
 #include "Utils.h"
 #include <algorithm>
+#include <cmath>
+#include <future>
+#include <numeric>
 #include <sstream>
+#include <thread>
+#include <tuple>
 #include <utility>
+#include <boost/unordered_set.hpp>
 #include "DisjointSets.h"
+#include "GroupAgents.h"
+#include "OccupancyIndex.h"
 
-CBS::CTNode::CTNode(const Paths& ps, const size_t cost): paths(ps), cost(cost){}
+void CBS::Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k)
+{
+    this->K = k;
+    this->ih = &ih;
+    this->policy = policy;
+    llp->Init(policy, ih);
+    cats.clear();
+    cats[llp] = std::make_unique<ConflictAvoidanceTable>();
+}
+
+CBS::CTNode::CTNode(const SharedSegmentedPaths& ps, const size_t cost): paths(ps), cost(cost){}
 
 bool CBS::CTNode::operator == (const CBS::CTNode& other) const noexcept
 {
-    return constraints == other.constraints;
+    return hash == other.hash;
 }
 
 bool CBS::CTNode::operator < (const CBS::CTNode& other) const noexcept
 {
-    return cost < other.cost || (cost == other.cost && h < other.h);
+    const size_t f = cost + h, other_f = other.cost + other.h;
+    return f < other_f || (f == other_f && nconflicts < other.nconflicts);
 }
 
 CBS::CTNode::operator bool() const
@@ -34,9 +56,10 @@ std::string CBS::CTNode::ToString(void) const
     std::stringstream ss;
     ss << "CT node. Cost: " << cost << '\n';
 
-    for(const auto& c: constraints)
+    for(const auto& [agent_index, chain]: constraints)
     {
-        ss << c << '\n';
+        for(auto link = chain.get(); link; link = link->parent.get())
+            ss << link->c << '\n';
     }
 
     return ss.str();
@@ -47,19 +70,7 @@ bool CBS::CTNode::Comparator::operator()(const CTNode& n1, const CTNode& n2) con
     return !(n1 < n2);
 }
 
-size_t CBS::CTNode::Hasher::operator()(const Constraints& cs) const noexcept
-{
-    // we apply xor since SAME constraints might appear in a different order at DIFFERENT ConstraintTreeNode
-    std::size_t seed = 0, xor_hashes = 0;
-    const Constraint::Hasher constraint_hasher;
-
-    std::for_each(cs.begin(), cs.end(), [&](const auto& constraint){xor_hashes = xor_hashes ^ constraint_hasher(constraint);});
-
-    boost::hash_combine(seed, xor_hashes);
-    return seed;
-}
-
-CBS::CBS(ILowLevelPlanner* llp): llp(llp), lookup(), high_level_nexpansions(0), low_level_nexpansions(0), K(300), previous_constraints(){}
+CBS::CBS(ILowLevelPlanner* llp, const Heuristic heuristic, const bool is_symmetry_reasoning): llp(llp), heuristic(heuristic), is_symmetry_reasoning(is_symmetry_reasoning), lookup(), high_level_nexpansions(0), low_level_nexpansions(0), K(300), previous_constraints(){}
 
 PlanResult CBS::Plan(const Graph& g, const Agents& as, const float timeout)
 {
@@ -89,24 +100,16 @@ std::tuple<bool, unsigned long> CBS::Replan(const Graph& g, const Agents& all, P
     bool is_replanning_succeed = ReplanAffectedGroups(disjoint_groups, g, all, ongoing_plans, affected, timer.GetRemainingRuntime(), current_timestep);
     bool exist_conflicting_group = true;
 
-    while(!timer.ExceedsRuntime() && exist_conflicting_group && is_replanning_succeed)
+    while(!timer.ExceedsRuntime() && !IsCancelled() && exist_conflicting_group && is_replanning_succeed)
     {
-        exist_conflicting_group = false;
+        Groups merged_conflicting_groups;
         
-        for(const auto& conflicting_groups_indicies: ConflictingGroups(disjoint_groups, ongoing_plans, all))
+        for(const auto& conflicting_groups_indicies: ConflictingGroups(disjoint_groups, ongoing_plans))
         {
             if(conflicting_groups_indicies.size() > 1)
             {
-                auto merged_conflicting_group = Merge(disjoint_groups, conflicting_groups_indicies);
-                is_replanning_succeed = ReplanGroup(merged_conflicting_group, g, all, ongoing_plans, timer.GetRemainingRuntime(), current_timestep);
-                
-                if(!is_replanning_succeed)
-                {
-                    break;
-                }
-                
-                next_disjoint_groups.push_back(merged_conflicting_group);
-                exist_conflicting_group = true;
+                merged_conflicting_groups.push_back(Merge(disjoint_groups, conflicting_groups_indicies));
+                next_disjoint_groups.push_back(merged_conflicting_groups.back());
             }
             else
             {
@@ -114,6 +117,10 @@ std::tuple<bool, unsigned long> CBS::Replan(const Graph& g, const Agents& all, P
             }
         }
 
+        // groups merged in the same round are disjoint, hence they are solved concurrently
+        exist_conflicting_group = !merged_conflicting_groups.empty();
+        is_replanning_succeed = ReplanGroups(merged_conflicting_groups, g, all, ongoing_plans, timer.GetRemainingRuntime(), current_timestep);
+
         disjoint_groups = std::forward<Groups>(next_disjoint_groups);
         next_disjoint_groups.clear();
     }
@@ -128,6 +135,9 @@ std::tuple<bool, Paths, Constraints> CBS::Search(const Graph& g, const Agents& a
     MinFibHeap open;
     Timer timer;
     bool is_plan_found = false;
+    llp->Invalidate();
+    mdds.clear();
+    pair_weights.clear();
     auto root = Init(g, as);
     if(root)
     {
@@ -136,50 +146,54 @@ std::tuple<bool, Paths, Constraints> CBS::Search(const Graph& g, const Agents& a
     
     timer.Start(timeout);
 
-    while(!open.empty() && !timer.ExceedsRuntime() && !is_plan_found)
+    while(!open.empty() && !timer.ExceedsRuntime() && !IsCancelled() && !is_plan_found)
     {
         auto n = open.top();
         open.pop();
 
-        auto conflicts = Validator::FindConflicts(n.paths);
-        is_plan_found = conflicts.empty();
+        is_plan_found = n.conflicts.IsEmpty();
         if(is_plan_found)
         {
             goal = std::forward<CTNode>(n);
         }
         else
         {
-            IConflict* c = conflicts.front();
+            auto [c, cardinality] = ChooseConflict(n, g, as);
+            nsplit[(int)cardinality] += 1;
             for(auto&& s: Expand(n, c, g, as))
             {
                 open.push(s);
             }
-            Validator::Free(conflicts);
+            delete c;
         }
     }
     
     lookup.clear();
     
-    return {is_plan_found && !timer.ExceedsRuntime(), goal.paths, goal.constraints};
+    return {is_plan_found && !timer.ExceedsRuntime(), Materialize(goal.paths), Collect(goal.constraints)};
 }
 
-CBS::CTNode CBS::Init(const Graph& g, const Agents& as)
+CBS::CTNode CBS::Init(const Graph& g, const Agents& as, const ConstraintIndex& constraints)
 {
     CTNode root;
-    root.paths.resize(K);
-    SafeIntervals si;
+    root.paths.resize(as.size());
+    root.lower_bounds.resize(as.size(), 0);
     bool is_solvable_scenario = true;
+    is_four_connected = std::none_of(g.GetEdges().begin(), g.GetEdges().end(), [](const Edge& e){return e.IsDiagonalEdge();});
 
     for(const auto& a: as)
     {
         if(!Agent::IsPlaceholderAgent(a))
         {
-            auto&& [p, low_level_nexpansions] = llp->Search(g, a, si);
+            const auto chain = ChainOf(constraints, a.index);
+            SafeIntervals si(chain.get());
+            auto&& [p, low_level_nexpansions] = llp->Search(g, a, si, ConstraintChain::KeyOf(chain));
             low_level_nexpansions += low_level_nexpansions;
 
             if(!p.empty())
             {
-                root.paths[a.index] = std::forward<Path>(p);
+                root.paths[a.index] = std::make_shared<const SegmentedPath>(p);
+                root.lower_bounds[a.index] = LowerBoundOf(root.paths[a.index], llp);
             }
             else
             {
@@ -192,7 +206,20 @@ CBS::CTNode CBS::Init(const Graph& g, const Agents& as)
 
     if(is_solvable_scenario)
     {
-        root.cost = ObjectiveFunction::SumOfCost(root.paths);
+        root.constraints = constraints;
+        for(const auto& [agent_index, chain]: constraints)
+        {
+            root.hash ^= chain->key;
+        }
+        root.cost = 0;
+        for(const auto& p: root.paths)
+        {
+            root.cost += PathLength(p);
+        }
+        root.lower_bound = std::accumulate(root.lower_bounds.begin(), root.lower_bounds.end(), 0);
+        root.conflicts.Build(root.paths);
+        root.nconflicts = root.conflicts.Count();
+        root.h = HeuristicOf(root, g, as, llp);
         high_level_nexpansions += 1;
     }
     else
@@ -209,18 +236,19 @@ CBS::Successors CBS::Expand(const CTNode& n, const IConflict* conf, const Graph&
 
     for(const auto& new_constraint: conf->Resolve())
     {
-        Constraints successor_constraints = n.constraints;
-        successor_constraints.insert(new_constraint);
+        // we apply xor since SAME constraints might be imposed in a different order at DIFFERENT CT nodes
+        const auto successor_hash = n.hash ^ Constraint::Hasher{}(new_constraint);
 
-        if(!lookup.contains(h(successor_constraints))) // no CTNode with the same constraints is generated
+        if(!lookup.contains(successor_hash)) // no CTNode with the same constraints is generated
         {
             high_level_nexpansions += 1;
-            auto successor = Generate(g, as[new_constraint.constrained_agent], n.paths, std::forward<Constraints>(successor_constraints));
+            auto successor = Generate(g, as[new_constraint.constrained_agent], n, new_constraint, llp);
 
             if(successor)
             {
-                assert(Validator::GetCoordinateAt(successor.paths[new_constraint.constrained_agent], new_constraint.timestep) != new_constraint.c);
-                lookup.insert(h(successor.constraints));
+                assert(new_constraint.kind != Constraint::Kind::Vertex || successor.paths[new_constraint.constrained_agent]->At(new_constraint.timestep) != new_constraint.c);
+                lookup.insert(successor.hash);
+                successor.h = HeuristicOf(successor, g, as, llp);
                 ss.push_back(successor);
             }
         }
@@ -229,43 +257,392 @@ CBS::Successors CBS::Expand(const CTNode& n, const IConflict* conf, const Graph&
     return ss;
 }
 
-CBS::CTNode CBS::Generate(const Graph& g, const Agent& a, const Paths& ps, Constraints&& cs)
+CBS::CTNode CBS::Generate(const Graph& g, const Agent& a, const CTNode& parent, const Constraint& new_constraint, ILowLevelPlanner* planner)
 {
     CTNode n;
-    SafeIntervals si(cs, a.index);
-    auto&& [p, low_level_nexpansions] = llp->Search(g, a, si);
+    const auto iter = parent.constraints.find(a.index);
+    const auto parent_chain = (iter != parent.constraints.end()) ? iter->second : nullptr;
+    assert(!ConstraintChain::Contains(parent_chain.get(), new_constraint));
+
+    auto chain = ConstraintChain::Push(parent_chain, new_constraint);
+    SafeIntervals si(chain.get());
+
+    // among equally short paths, the one which collides the least with the other paths of the parent is preferred
+    const auto cat = cats.find(planner);
+    if(cat != cats.end())
+    {
+        cat->second->Sync(parent.paths);
+        planner->SetConflictAvoidanceTable(cat->second.get());
+    }
+    auto&& [p, low_level_nexpansions] = planner->Resume(g, a, si, chain->key, ConstraintChain::KeyOf(parent_chain), new_constraint);
+    planner->SetConflictAvoidanceTable(nullptr);
     low_level_nexpansions += low_level_nexpansions;
 
     if(!p.empty())
     {
-        n.paths = ps;
-        n.paths[a.index] = std::forward<Path>(p);
-        n.constraints = std::forward<Constraints>(cs);
-        n.cost = ObjectiveFunction::SumOfCost(n.paths);
-        n.h = NumberOfConflicts(n.paths);
+        n.paths = parent.paths;
+        n.paths[a.index] = std::make_shared<const SegmentedPath>(p);
+        n.cost = parent.cost - PathLength(parent.paths[a.index]) + PathLength(n.paths[a.index]);
+        n.lower_bounds = parent.lower_bounds;
+        n.lower_bounds[a.index] = LowerBoundOf(n.paths[a.index], planner);
+        n.lower_bound = parent.lower_bound - parent.lower_bounds[a.index] + n.lower_bounds[a.index];
+        n.constraints = parent.constraints;
+        n.constraints[a.index] = std::move(chain);
+        n.hash = parent.hash ^ Constraint::Hasher{}(new_constraint);
+        n.conflicts = parent.conflicts;
+        n.conflicts.Update(a.index, n.paths);
+        n.nconflicts = n.conflicts.Count();
+
+        ngenerated += 1;
+        for(int i = 0; i < (int)n.paths.size(); i++)
+        {
+            if(i != a.index && n.paths[i])
+                shared_bytes += n.paths[i]->GetSegments().size() * sizeof(Segment);
+        }
     }
 
     return n;
 }
 
-int CBS::NumberOfConflicts(const Paths& ps)
+Constraints CBS::Collect(const ConstraintIndex& index)
 {
-    auto confs = Validator::FindConflicts(ps);
-    auto n = confs.size();
-    Validator::Free(confs);
-    return n;
+    Constraints cs;
+    std::vector<int> agents;
+    agents.reserve(index.size());
+    std::transform(index.begin(), index.end(), std::back_inserter(agents), [](const auto& entry){return entry.first;});
+
+    // the iteration order of index depends on how many times it was copied, agents are visited in a fixed order so the
+    // partition into groups of ID does not depend on it
+    std::sort(agents.begin(), agents.end());
+    for(const int agent_index: agents)
+    {
+        for(auto link = index.at(agent_index).get(); link; link = link->parent.get())
+            cs.insert(link->c);
+    }
+
+    return cs;
+}
+
+std::tuple<IConflict*, CBS::Cardinality> CBS::ChooseConflict(const CTNode& n, const Graph& g, const Agents& as)
+{
+    // the most constraining conflict is chosen, ties are broken in favour of earlier conflicts
+    auto conflicts = n.conflicts.EarliestOfEachPair();
+    if(conflicts.size() == 1)
+    {
+        return {Reason(n, conflicts.front(), g, as), Cardinality::Unclassified};
+    }
+
+    int chosen = -1;
+    auto chosen_cardinality = Cardinality::NonCardinal;
+
+    for(int i = 0; i < (int)conflicts.size() && chosen_cardinality != Cardinality::Cardinal; i++)
+    {
+        const auto cardinality = Classify(n, conflicts[i], g, as);
+        if(chosen < 0 || cardinality < chosen_cardinality)
+        {
+            chosen = i;
+            chosen_cardinality = cardinality;
+        }
+    }
+
+    IConflict* c = conflicts[chosen];
+    conflicts.erase(conflicts.begin() + chosen);
+    Validator::Free(conflicts);
+
+    return {Reason(n, c, g, as), chosen_cardinality};
+}
+
+IConflict* CBS::Reason(const CTNode& n, IConflict* conflict, const Graph& g, const Agents& as)
+{
+    if(!is_symmetry_reasoning)
+        return conflict;
+
+    IConflict* symmetric = nullptr;
+    if((symmetric = SymmetryReasoning::Target(conflict, n.paths)))
+        ntarget_conflicts += 1;
+    else if((symmetric = SymmetryReasoning::Corridor(conflict, n.paths, g, as)))
+        ncorridor_conflicts += 1;
+    else if(is_four_connected && (symmetric = SymmetryReasoning::Rectangle(conflict, n.paths)))
+        nrectangle_conflicts += 1;
+
+    if(!symmetric)
+        return conflict;
+
+    delete conflict;
+    return symmetric;
+}
+
+CBS::Cardinality CBS::Classify(const CTNode& n, const IConflict* conflict, const Graph& g, const Agents& as)
+{
+    int ncost_increasing = 0;
+
+    // a child's cost increases iff all of its agent's paths of the current cost violate the new constraint
+    for(const auto& c: conflict->Resolve())
+    {
+        if(MDDOf(n, c.constrained_agent, g, as).IsSingletonAt(c.c, c.timestep))
+            ncost_increasing += 1;
+    }
+
+    return ncost_increasing == 2 ? Cardinality::Cardinal : (ncost_increasing == 1 ? Cardinality::SemiCardinal : Cardinality::NonCardinal);
+}
+
+const MDD& CBS::MDDOf(const CTNode& n, const int agent_index, const Graph& g, const Agents& as)
+{
+    const auto chain = ChainOf(n.constraints, agent_index);
+    const int cost = PathLength(n.paths[agent_index]);
+
+    size_t key = 0;
+    boost::hash_combine(key, agent_index);
+    boost::hash_combine(key, ConstraintChain::KeyOf(chain));
+    boost::hash_combine(key, cost);
+
+    {
+        std::lock_guard lock(cache_mutex);
+        const auto iter = mdds.find(key);
+        if(iter != mdds.end())
+            return *iter->second;
+    }
+
+    // built outside the lock, a concurrent build of the same MDD is discarded. Cached MDDs are never freed during a search
+    auto mdd = std::make_shared<const MDD>(g, as[agent_index], *ih, chain.get(), cost);
+    std::lock_guard lock(cache_mutex);
+    const auto [iter, is_inserted] = mdds.try_emplace(key, std::move(mdd));
+    nmdds += is_inserted;
+
+    return *iter->second;
+}
+
+int CBS::HeuristicOf(const CTNode& n, const Graph& g, const Agents& as, ILowLevelPlanner* planner)
+{
+    if(heuristic == Heuristic::None)
+        return 0;
+
+    DependencyGraph dg;
+    auto conflicts = n.conflicts.EarliestOfEachPair();
+
+    for(const auto c: conflicts)
+    {
+        dg.AddEdge(c->agents_indices[0], c->agents_indices[1], PairWeight(n, c, g, as, planner));
+    }
+    Validator::Free(conflicts);
+
+    return dg.MinimumVertexCover();
+}
+
+int CBS::PairWeight(const CTNode& n, const IConflict* conflict, const Graph& g, const Agents& as, ILowLevelPlanner* planner)
+{
+    const int i = conflict->agents_indices[0], j = conflict->agents_indices[1];
+    const long ci = PathLength(n.paths[i]), cj = PathLength(n.paths[j]);
+
+    // the weight depends only on the constraints imposed on both agents, which also determine their costs
+    size_t key = 0;
+    boost::hash_combine(key, i);
+    boost::hash_combine(key, j);
+    boost::hash_combine(key, ConstraintChain::KeyOf(ChainOf(n.constraints, i)));
+    boost::hash_combine(key, ConstraintChain::KeyOf(ChainOf(n.constraints, j)));
+    boost::hash_combine(key, ci);
+    boost::hash_combine(key, cj);
+
+    {
+        std::lock_guard lock(cache_mutex);
+        const auto iter = pair_weights.find(key);
+        if(iter != pair_weights.end())
+        {
+            npair_cache_hits += 1;
+            return iter->second;
+        }
+    }
+
+    int weight = Classify(n, conflict, g, as) == Cardinality::Cardinal;
+
+    if(heuristic != Heuristic::CG && !weight)
+    {
+        weight = AreDependent(MDDOf(n, i, g, as), MDDOf(n, j, g, as), g);
+    }
+
+    if(heuristic == Heuristic::WDG && weight)
+    {
+        weight = std::max<long>(1, PairCost(n, i, j, g, as, planner) - ci - cj);
+    }
+
+    std::lock_guard lock(cache_mutex);
+    npair_evaluations += 1;
+    pair_weights[key] = weight;
+    return weight;
+}
+
+long CBS::PairCost(const CTNode& n, const int i, const int j, const Graph& g, const Agents& as, ILowLevelPlanner* planner)
+{
+    // CBS over agents i and j alone, starting from the constraints of n
+    struct PairNode
+    {
+        std::array<ConstraintChain::Ptr, 2> chains;
+        std::array<SharedSegmentedPath, 2> paths;
+        long cost = 0;
+
+        struct Comparator{bool operator() (const PairNode& n1, const PairNode& n2) const noexcept {return n1.cost > n2.cost;}};
+    };
+
+    const std::array<int, 2> agents{i, j};
+    boost::heap::fibonacci_heap<PairNode, boost::heap::compare<PairNode::Comparator>> open;
+    open.push({{ChainOf(n.constraints, i), ChainOf(n.constraints, j)}, {n.paths[i], n.paths[j]}, PathLength(n.paths[i]) + PathLength(n.paths[j])});
+    long lower_bound = open.top().cost;
+
+    for(int nexpansions = 0; !open.empty() && nexpansions < PAIR_SEARCH_BUDGET; nexpansions++)
+    {
+        const auto top = open.top();
+        open.pop();
+        lower_bound = top.cost;
+
+        IConflict* conflict = ConflictTable::EarliestBetween(i, j, *top.paths[0], *top.paths[1]);
+        if(!conflict)
+            return top.cost;
+
+        for(const auto& c: conflict->Resolve())
+        {
+            const int k = (c.constrained_agent == i) ? 0 : 1;
+            auto child = top;
+            child.chains[k] = ConstraintChain::Push(top.chains[k], c);
+            SafeIntervals si(child.chains[k].get());
+            auto&& [p, low_level_nexpansions] = planner->Resume(g, as[agents[k]], si, child.chains[k]->key, ConstraintChain::KeyOf(top.chains[k]), c);
+
+            if(!p.empty())
+            {
+                child.paths[k] = std::make_shared<const SegmentedPath>(p);
+                child.cost = top.cost - PathLength(top.paths[k]) + PathLength(child.paths[k]);
+                open.push(child);
+            }
+        }
+        delete conflict;
+    }
+
+    // costs along the open list never decrease, hence its top bounds the cost of the pair from below
+    return open.empty() ? lower_bound : std::max(lower_bound, open.top().cost);
+}
+
+bool CBS::AreDependent(const MDD& m1, const MDD& m2, const Graph& g)
+{
+    if(m1.LayerAt(0).empty() || m2.LayerAt(0).empty())
+        return false;
+
+    // depth-first search over the joint MDD for a pair of non-conflicting paths, an agent stays at its goal once its path ends
+    const int depth = std::max(m1.GetCost(), m2.GetCost());
+    std::vector<CoordinateSet> layers1, layers2;
+    for(int t = 0; t <= depth; t++)
+    {
+        layers1.emplace_back(m1.LayerAt(t).begin(), m1.LayerAt(t).end());
+        layers2.emplace_back(m2.LayerAt(t).begin(), m2.LayerAt(t).end());
+    }
+
+    auto children = [&g](const CoordinateSet& next, const Coordinate& u)
+    {
+        std::vector<Coordinate> out;
+        if(next.contains(u))
+            out.push_back(u); // wait
+        for(const auto& v: g.AdjacentOf(u))
+        {
+            if(next.contains(v))
+                out.push_back(v);
+        }
+        return out;
+    };
+
+    const size_t n = g.GetNumberOfIndices();
+    boost::unordered_set<size_t> visited;
+    std::vector<std::tuple<Coordinate, Coordinate, int>> stack{{m1.LayerAt(0).front(), m2.LayerAt(0).front(), 0}};
+
+    while(!stack.empty())
+    {
+        const auto [u1, u2, t] = stack.back();
+        stack.pop_back();
+
+        if(t == depth)
+            return false;
+
+        for(const auto& v1: children(layers1[t + 1], u1))
+        {
+            const auto crossing_edges = Edge{u1, v1}.GetCrossingEdges();
+
+            for(const auto& v2: children(layers2[t + 1], u2))
+            {
+                if(v1 == v2 || std::find(crossing_edges.begin(), crossing_edges.end(), Edge{u2, v2}) != crossing_edges.end())
+                    continue;
+
+                if(visited.insert((g.IndexOf(v1) * n + g.IndexOf(v2)) * (depth + 1) + t + 1).second)
+                    stack.emplace_back(v1, v2, t + 1);
+            }
+        }
+    }
+
+    return true;
+}
+
+ConstraintChain::Ptr CBS::ChainOf(const ConstraintIndex& index, const int agent_index)
+{
+    const auto iter = index.find(agent_index);
+    return (iter != index.end()) ? iter->second : nullptr;
+}
+
+std::string CBS::GetHeuristicName(void) const
+{
+    switch(heuristic)
+    {
+        case Heuristic::CG: return "-CG";
+        case Heuristic::DG: return "-DG";
+        case Heuristic::WDG: return "-WDG";
+        default: return "";
+    }
+}
+
+long CBS::PathLength(const SharedSegmentedPath& p)
+{
+    return (p && !p->IsEmpty()) ? p->Length() - 1 : 0;
+}
+
+int CBS::LowerBoundOf(const SharedSegmentedPath& p, const ILowLevelPlanner* planner)
+{
+    // costs are integral, hence a fractional bound may be rounded up
+    return std::min<long>(PathLength(p), std::ceil(planner->GetLowerBound()));
+}
+
+Paths CBS::Materialize(const SharedSegmentedPaths& ps)
+{
+    Paths out;
+    out.reserve(ps.size());
+    std::transform(ps.begin(), ps.end(), std::back_inserter(out), [](const auto& p){return p ? p->Expand() : Path{};});
+    return out;
+}
+
+std::string CBS::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#Generated CT nodes: " << ngenerated << '\n';
+    ss << "Avg. path bytes shared per CT node: " << (ngenerated > 0 ? shared_bytes / ngenerated : 0) << '\n';
+    ss << "#Cardinal conflicts split: " << nsplit[(int)Cardinality::Cardinal] << '\n';
+    ss << "#Semi-cardinal conflicts split: " << nsplit[(int)Cardinality::SemiCardinal] << '\n';
+    ss << "#Non-cardinal conflicts split: " << nsplit[(int)Cardinality::NonCardinal] << '\n';
+    ss << "#Unclassified conflicts split: " << nsplit[(int)Cardinality::Unclassified] << '\n';
+    ss << "#Pairwise heuristic evaluations: " << npair_evaluations << '\n';
+    ss << "#Pairwise heuristic cache hits: " << npair_cache_hits << '\n';
+    ss << "#MDDs built: " << nmdds << '\n';
+    ss << "#Groups replanned concurrently: " << nconcurrent_groups << '\n';
+    ss << "#Target conflicts reasoned: " << ntarget_conflicts << '\n';
+    ss << "#Corridor conflicts reasoned: " << ncorridor_conflicts << '\n';
+    ss << "#Rectangle conflicts reasoned: " << nrectangle_conflicts << '\n';
+    ss << "#Paths re-indexed in conflict-avoidance tables: " << std::accumulate(cats.begin(), cats.end(), 0ul, [](const unsigned long sum, const auto& entry){return sum + entry.second->GetReindexed();}) << '\n';
+    return ss.str() + (llp ? llp->GetStats() : "");
 }
 
 CBS::Groups CBS::Partition(const Agents& all, const int current_timestep)
 {
     Groups disjoint_groups;
-    DisjointSets ds(K);
+    DisjointSets ds(all.size());
     auto iter = previous_constraints.begin();
 
     while(iter != previous_constraints.end())
     {
         const auto& c = *iter;
-        if(c.timestep >= current_timestep)
+        if(c.LastTimestep() >= current_timestep)
         {
             if(!Agent::IsPlaceholderAgent(all[c.constrained_agent]) && !Agent::IsPlaceholderAgent(all[c.conflicted_agent]))
             {
@@ -289,28 +666,111 @@ CBS::Groups CBS::Partition(const Agents& all, const int current_timestep)
 
 bool CBS::ReplanAffectedGroups(const Groups& disjoint_groups, const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, const float timeout, const int current_timestep)
 {
-    Timer timer;
-    timer.Start(timeout);
-    bool is_replanning_succeed = true;
+    Groups affected_groups;
+    std::copy_if(disjoint_groups.begin(), disjoint_groups.end(), std::back_inserter(affected_groups), [&affected](const auto& group)
+    {
+        return std::any_of(group.begin(), group.end(), [&affected](const auto i){return affected.contains(i);});
+    });
+
+    return ReplanGroups(affected_groups, g, all, ongoing_plans, timeout, current_timestep);
+}
 
-    for(const auto& group: disjoint_groups)
+bool CBS::ReplanGroups(const Groups& groups, const Graph& g, const Agents& all, Paths& ongoing_plans, const float timeout, const int current_timestep)
+{
+    if(groups.size() > 1)
     {
-        if(std::any_of(group.begin(), group.end(), [&affected](const auto i){return affected.contains(i);}))
+        return ReplanGroupsConcurrently(groups, g, all, ongoing_plans, timeout, current_timestep);
+    }
+
+    return groups.empty() || ReplanGroup(groups.front(), g, all, ongoing_plans, timeout, current_timestep);
+}
+
+bool CBS::ReplanGroup(const AgentsIndicesSet& group, const Graph& g, const Agents& all, Paths& ongoing_plans, const float timeout, const int current_timestep)
+{
+    ForgetConstraints(group);
+
+    auto&& [is_plan_found, current_constraints] = SolveGroup(group, g, all, ongoing_plans, timeout);
+
+    if(is_plan_found)
+    {
+        RememberConstraints(current_constraints, current_timestep);
+    }
+    return is_plan_found;
+}
+
+bool CBS::ReplanGroupsConcurrently(const Groups& groups, const Graph& g, const Agents& all, Paths& ongoing_plans, const float timeout, const int current_timestep)
+{
+    using Outcome = std::tuple<bool, Constraints>;
+
+    if(!group_pool)
+    {
+        const int nworkers = std::max(1u, std::thread::hardware_concurrency());
+        for(int i = 0; i < nworkers; i++)
         {
-            is_replanning_succeed = ReplanGroup(group, g, all, ongoing_plans, timer.GetRemainingRuntime(), current_timestep);
-            if(!is_replanning_succeed)
-            {
-                break;
-            }
+            forks.emplace_back(Fork());
+            forks.back()->Init(policy, *ih, K);
+            forks.back()->SetCancellationFlag(is_cancelled);
         }
+        group_pool = std::make_unique<WorkStealingPool>(nworkers);
+    }
+
+    // a worker solves its groups one after the other, each group is given an equal share of the time of the worker it runs on
+    const int N = groups.size();
+    const int nrounds = (N + forks.size() - 1) / forks.size();
+    const float group_timeout = timeout / nrounds;
+    std::vector<std::promise<Outcome>> outcomes(N);
+    std::vector<std::future<Outcome>> results;
+
+    for(int i = 0; i < N; i++)
+    {
+        ForgetConstraints(groups[i]);
+        results.push_back(outcomes[i].get_future());
+    }
+
+    // groups are disjoint, hence each worker writes its own slots of ongoing_plans only
+    for(int i = 0; i < N; i++)
+    {
+        group_pool->Submit([this, i, &groups, &g, &all, &ongoing_plans, &outcomes, group_timeout](const int worker_index)
+        {
+            outcomes[i].set_value(forks[worker_index]->SolveGroup(groups[i], g, all, ongoing_plans, group_timeout));
+        });
     }
 
+    bool is_replanning_succeed = true;
+    for(int i = 0; i < N; i++)
+    {
+        auto&& [is_plan_found, current_constraints] = results[i].get();
+        if(is_plan_found)
+        {
+            RememberConstraints(current_constraints, current_timestep);
+        }
+        is_replanning_succeed = is_replanning_succeed && is_plan_found;
+    }
+
+    for(auto& fork: forks)
+    {
+        Absorb(*fork);
+    }
+    nconcurrent_groups += N;
+
     return is_replanning_succeed;
 }
 
-bool CBS::ReplanGroup(const AgentsIndicesSet& group, const Graph& g, const Agents& all, Paths& ongoing_plans, const float timeout, const int current_timestep)
+std::tuple<bool, Constraints> CBS::SolveGroup(const AgentsIndicesSet& group, const Graph& g, const Agents& all, Paths& ongoing_plans, const float timeout)
+{
+    const GroupAgents group_agents(group, all);
+    auto&& [is_plan_found, paths, current_constraints] = Search(g, group_agents.Local(), timeout);
+
+    if(is_plan_found)
+    {
+        group_agents.Scatter(std::move(paths), ongoing_plans);
+        return {true, group_agents.Globalize(current_constraints)};
+    }
+    return {false, Constraints{}};
+}
+
+void CBS::ForgetConstraints(const AgentsIndicesSet& group)
 {
-    // // remove previous group constraints
     auto iter = previous_constraints.begin();
     while(iter != previous_constraints.end())
     {
@@ -324,57 +784,61 @@ bool CBS::ReplanGroup(const AgentsIndicesSet& group, const Graph& g, const Agent
             iter++;
         }
     }
+}
 
-    // plan for the group
-    auto&& [is_plan_found, paths, current_constraints] = Search(g, ExtractGroupAgents(group, all), timeout);
-
-    if(is_plan_found)
+void CBS::RememberConstraints(const Constraints& cs, const int current_timestep)
+{
+    // CBS planning from timestep 0, although current timestep is later.
+    for(auto c: cs)
     {
-        for(const auto i: group)
-        {
-            ongoing_plans[i] = std::forward<Path>(paths[i]);
-        }
-        // CBS planning from timestep 0, although current timestep is later.
-        for(const auto& c: current_constraints)
-        {
-            previous_constraints.insert({c.constrained_agent, c.conflicted_agent, c.c, c.timestep + current_timestep});
-        }
+        c.Shift(current_timestep);
+        previous_constraints.insert(c);
     }
-    return is_plan_found;
 }
 
-Agents CBS::ExtractGroupAgents(const AgentsIndicesSet& group, const Agents& all)
+CBS* CBS::Fork(void) const
+{
+    return new CBS(llp->Clone(), heuristic, is_symmetry_reasoning);
+}
+
+void CBS::Absorb(CBS& fork)
 {
-    Agents group_agents(K);
-    for(const auto i: group)
+    high_level_nexpansions += std::exchange(fork.high_level_nexpansions, 0);
+    low_level_nexpansions += std::exchange(fork.low_level_nexpansions, 0);
+    for(size_t i = 0; i < nsplit.size(); i++)
     {
-        group_agents[i] = all[i];
+        nsplit[i] += std::exchange(fork.nsplit[i], 0);
     }
-    return group_agents;
+    nmdds += std::exchange(fork.nmdds, 0);
+    npair_evaluations += std::exchange(fork.npair_evaluations, 0);
+    npair_cache_hits += std::exchange(fork.npair_cache_hits, 0);
+    ngenerated += fork.ngenerated.exchange(0);
+    shared_bytes += fork.shared_bytes.exchange(0);
+    ntarget_conflicts += fork.ntarget_conflicts.exchange(0);
+    ncorridor_conflicts += fork.ncorridor_conflicts.exchange(0);
+    nrectangle_conflicts += fork.nrectangle_conflicts.exchange(0);
 }
 
-std::vector<std::vector<int>> CBS::ConflictingGroups(const Groups& disjoint_groups, const Paths& ongoing_plans, const Agents& all)
+std::vector<std::vector<int>> CBS::ConflictingGroups(const Groups& disjoint_groups, const Paths& ongoing_plans)
 {
     const int N = disjoint_groups.size();
     DisjointSets ds(N);
-    
+    OccupancyIndex index;
+
+    // a single pass over all plans, groups conflict iff their plans collide in the index
     for(int i = 0; i < N; i++)
     {
-        for(int j = i + 1; j < N; j++)
+        for(const auto agent_index: disjoint_groups[i])
         {
-            Paths groups_merged_paths;
-            const auto& g1 = disjoint_groups[i], g2 = disjoint_groups[j];
-
-            std::for_each(g1.begin(), g1.end(), [&groups_merged_paths, &ongoing_plans](const auto i){groups_merged_paths.push_back(ongoing_plans[i]);});
-            std::for_each(g2.begin(), g2.end(), [&groups_merged_paths, &ongoing_plans](const auto i){groups_merged_paths.push_back(ongoing_plans[i]);});
-
-            if(Validator::ExistsConflict(groups_merged_paths))
-            {
-                ds.Union(i, j);
-            }
+            index.Insert(ongoing_plans[agent_index], i);
         }
     }
 
+    for(const auto& [i, j]: index.Collisions())
+    {
+        ds.Union(i, j);
+    }
+
     return ds.GetDisjointSets();
 }
 
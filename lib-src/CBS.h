@@ -1,10 +1,19 @@
 #pragma once
 
+#include "ConflictAvoidanceTable.h"
+#include "ConflictTable.h"
+#include "ConstraintChain.h"
 #include "Graph.h"
 #include "IConflict.h"
 #include "ILowLevelPlanner.h"
 #include "Types.h"
 #include "IHighLevelPlanner.h"
+#include "MDD.h"
+#include "WorkStealingPool.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <boost/heap/fibonacci_heap.hpp>
 
 class ILowLevelPlanner;
@@ -14,24 +23,41 @@ class InformedHeuristic;
 class CBS: public IHighLevelPlanner
 {
 public:
-    CBS(ILowLevelPlanner* llp);
-    virtual ~CBS() {delete llp; llp = nullptr;}
+    // admissible high-level heuristic, the minimum vertex cover of a dependency graph between the agents of a CT node. An edge connects agents with
+    // a cardinal conflict (CG), agents whose MDDs admit no pair of non-conflicting paths (DG), or the latter weighted by the cost of solving them (WDG)
+    enum class Heuristic {None, CG, DG, WDG};
+
+    // symmetry reasoning replaces rectangle, corridor and target conflicts by barrier, range and length constraints respectively
+    CBS(ILowLevelPlanner* llp, Heuristic heuristic=Heuristic::None, bool is_symmetry_reasoning=true);
+    virtual ~CBS() {group_pool.reset(); delete llp; llp = nullptr;}
     
     PlanResult Plan(const Graph& g, const Agents& as, float timeout) override;
     std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) override;
-    inline void Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k) override {this->K = k; llp->Init(policy, ih);};
-    inline std::string GetName(void) const override {return "CBS+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    inline std::string GetName(void) const override {return "CBS" + GetHeuristicName() + "+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    std::string GetStats(void) const override;
 
 protected:
+    // resolving a cardinal conflict increases the cost of both children, a semi-cardinal one of a single child.
+    // A conflict is left unclassified when there is no other conflict to choose from.
+    enum class Cardinality {Cardinal, SemiCardinal, NonCardinal, Unclassified};
+
+    using ConstraintIndex = boost::unordered_map<int, ConstraintChain::Ptr>; // agent index -> chain of constraints imposed on it
+
     struct CTNode
     {
         CTNode() = default;
-        CTNode(const Paths&, size_t cost);
+        CTNode(const SharedSegmentedPaths&, size_t cost);
         
-        Paths paths;
-        Constraints constraints;
+        SharedSegmentedPaths paths; // paths of agents which are not replanned are shared with the parent node
+        ConflictTable conflicts;
+        ConstraintIndex constraints;
+        size_t hash = 0; // xor of the hashes of all constraints, identifies the node for duplicates detection
         size_t cost = LONG_INF;
-        int h = 0; // breaking-tie in favour of nodes with lower number of conflicts
+        std::vector<int> lower_bounds; // lower_bounds[i] := f-min of the last low-level search of agent i
+        size_t lower_bound = 0; // sum of lower_bounds, equals to cost when the low-level planner is optimal
+        int h = 0; // admissible estimate of the cost increase required to resolve all conflicts
+        int nconflicts = 0; // breaking-tie in favour of nodes with lower number of conflicts
 
         std::string ToString(void) const;
 
@@ -40,36 +66,75 @@ protected:
         bool operator < (const CTNode& other) const noexcept;
         explicit operator bool() const;
 
-        // Hash a CT node according to its constraints.
-        struct Hasher{size_t operator() (const Constraints&) const noexcept;};
         struct Comparator{bool operator() (const CTNode&, const CTNode&) const noexcept;};
     };
 
     using MinFibHeap = boost::heap::fibonacci_heap<CTNode, boost::heap::compare<CTNode::Comparator>>;
-    using CTNodeSet = boost::unordered_set<size_t>; // set of hash of CTNode constraints, used for duplicates detection
+    using CTNodeSet = boost::unordered_set<size_t>; // set of CTNode::hash, used for duplicates detection
     using Successors = std::vector<CTNode>;
     using Groups = std::vector<AgentsIndicesSet>;
+    using MDDCache = boost::unordered_map<size_t, std::shared_ptr<const MDD>>; // <agent, constraints, cost> -> MDD
+    using PairCache = boost::unordered_map<size_t, int>; // <agents pair, their constraints, their costs> -> weight of their edge in the dependency graph
+    using ConflictAvoidanceTables = boost::unordered_map<const ILowLevelPlanner*, std::unique_ptr<ConflictAvoidanceTable>>;
+
+    static constexpr int PAIR_SEARCH_BUDGET = 64; // CT nodes expanded when solving a pair of agents for WDG, a lower bound is used beyond it
 
     ILowLevelPlanner* llp;
+    Heuristic heuristic;
+    bool is_symmetry_reasoning;
+    bool is_four_connected = true; // rectangle reasoning assumes no diagonal edges
     CTNodeSet lookup;
     unsigned long high_level_nexpansions;
     unsigned long low_level_nexpansions;
     size_t K;
+    const InformedHeuristic* ih = nullptr;
+    IPolicy* policy = nullptr;
+    MDDCache mdds;
+    std::array<unsigned long, 4> nsplit{}; // number of conflicts split, by Cardinality
+    unsigned long nmdds = 0;
+    PairCache pair_weights;
+    unsigned long npair_evaluations = 0, npair_cache_hits = 0;
+    std::mutex cache_mutex; // guards mdds, pair_weights and their counters, since CT nodes may be generated concurrently
+    std::atomic<unsigned long> ngenerated = 0; // number of generated CT nodes
+    std::atomic<unsigned long> shared_bytes = 0; // path bytes shared with parent nodes rather than copied
+    std::atomic<unsigned long> ntarget_conflicts = 0, ncorridor_conflicts = 0, nrectangle_conflicts = 0; // conflicts replaced by symmetry reasoning
+    ConflictAvoidanceTables cats; // table of each low-level planner, synced to the parent of the node it generates. Filled before any search
     Constraints previous_constraints;
-    static constexpr CTNode::Hasher h{};
+    std::vector<std::unique_ptr<CBS>> forks; // forks[i] := planner of worker i of group_pool
+    std::unique_ptr<WorkStealingPool> group_pool; // replans affected groups concurrently, created once more than a single group is affected
+    unsigned long nconcurrent_groups = 0; // number of groups replanned concurrently with another group
 
     // CBS methods
-    std::tuple<bool, Paths, Constraints> Search(const Graph& g, const Agents& as, float timeout);
-    CTNode Init(const Graph& g, const Agents& as);
+    virtual std::tuple<bool, Paths, Constraints> Search(const Graph& g, const Agents& as, float timeout);
+    CTNode Init(const Graph& g, const Agents& as, const ConstraintIndex& constraints={}); // constraints are imposed on the root already
     Successors Expand(const CTNode& n, const IConflict* c, const Graph& g, const Agents& as);
-    CTNode Generate(const Graph& g, const Agent& a, const Paths& ps, Constraints&& cs);
-    int NumberOfConflicts(const Paths& ps);
+    CTNode Generate(const Graph& g, const Agent& a, const CTNode& parent, const Constraint& new_constraint, ILowLevelPlanner* planner);
+    std::tuple<IConflict*, Cardinality> ChooseConflict(const CTNode& n, const Graph& g, const Agents& as);
+    IConflict* Reason(const CTNode& n, IConflict* conflict, const Graph& g, const Agents& as); // takes ownership of conflict
+    Cardinality Classify(const CTNode& n, const IConflict* conflict, const Graph& g, const Agents& as);
+    const MDD& MDDOf(const CTNode& n, int agent_index, const Graph& g, const Agents& as);
+    int HeuristicOf(const CTNode& n, const Graph& g, const Agents& as, ILowLevelPlanner* planner);
+    int PairWeight(const CTNode& n, const IConflict* conflict, const Graph& g, const Agents& as, ILowLevelPlanner* planner);
+    long PairCost(const CTNode& n, int i, int j, const Graph& g, const Agents& as, ILowLevelPlanner* planner);
+    static bool AreDependent(const MDD& m1, const MDD& m2, const Graph& g);
+    static ConstraintChain::Ptr ChainOf(const ConstraintIndex& index, int agent_index);
+    std::string GetHeuristicName(void) const;
+    static long PathLength(const SharedSegmentedPath& p);
+    static int LowerBoundOf(const SharedSegmentedPath& p, const ILowLevelPlanner* planner); // f-min of the low-level search of planner, which found p
+    static Paths Materialize(const SharedSegmentedPaths& ps);
+    static Constraints Collect(const ConstraintIndex& index);
+    virtual CBS* Fork(void) const; // planner of the same configuration with a low-level planner of its own, must be initialized before use
+    void Absorb(CBS& fork); // move the counters of fork into this planner
 
     // ID+CBS methods
     Groups Partition(const Agents& all, int current_timestep);
     bool ReplanAffectedGroups(const Groups& disjoint_groups, const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep);
+    bool ReplanGroups(const Groups& groups, const Graph& g, const Agents& all, Paths& ongoing_plans, float timeout, int current_timestep); // disjoint groups
     bool ReplanGroup(const AgentsIndicesSet& group, const Graph& g, const Agents& all, Paths& ongoing_plans, float timeout, int current_timestep);
-    Agents ExtractGroupAgents(const AgentsIndicesSet& g, const Agents& all);
-    std::vector<std::vector<int>> ConflictingGroups(const Groups& disjoint_groups, const Paths& ongoing_plans, const Agents& all);
+    bool ReplanGroupsConcurrently(const Groups& groups, const Graph& g, const Agents& all, Paths& ongoing_plans, float timeout, int current_timestep);
+    std::tuple<bool, Constraints> SolveGroup(const AgentsIndicesSet& group, const Graph& g, const Agents& all, Paths& ongoing_plans, float timeout); // writes the plans of group only
+    void ForgetConstraints(const AgentsIndicesSet& group);
+    void RememberConstraints(const Constraints& cs, int current_timestep);
+    std::vector<std::vector<int>> ConflictingGroups(const Groups& disjoint_groups, const Paths& ongoing_plans);
     AgentsIndicesSet Merge(const Groups& groups, const std::vector<int>& conflicting_groups_indices);
 };
\ No newline at end of file
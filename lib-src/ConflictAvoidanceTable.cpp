@@ -0,0 +1,83 @@
+#include "ConflictAvoidanceTable.h"
+#include <algorithm>
+
+void ConflictAvoidanceTable::Sync(const SharedSegmentedPaths& ps)
+{
+    if(indexed.size() != ps.size())
+    {
+        cells.clear();
+        indexed.assign(ps.size(), nullptr);
+    }
+
+    // paths are immutable and shared between nodes, an unchanged path keeps its address
+    for(int i = 0; i < (int)ps.size(); i++)
+    {
+        if(indexed[i] == ps[i])
+            continue;
+
+        if(indexed[i])
+            Erase(i, *indexed[i]);
+        if(ps[i])
+            Insert(i, *ps[i]);
+
+        indexed[i] = ps[i];
+        nreindexed += 1;
+    }
+}
+
+int ConflictAvoidanceTable::Count(const Coordinate& c, const int from, const int to, const int excluded_agent) const
+{
+    const auto iter = cells.find(c);
+    if(iter == cells.end() || from > to)
+        return 0;
+
+    return std::count_if(iter->second.begin(), iter->second.end(), [from, to, excluded_agent](const Occupancy& o)
+    {
+        return o.agent != excluded_agent && o.arrival <= to && from < o.departure;
+    });
+}
+
+int ConflictAvoidanceTable::CountSwaps(const Coordinate& u, const Coordinate& v, const int arrival, const int excluded_agent) const
+{
+    const auto iter = cells.find(v);
+    if(iter == cells.end())
+        return 0;
+
+    return std::count_if(iter->second.begin(), iter->second.end(), [this, &u, arrival, excluded_agent](const Occupancy& o)
+    {
+        return o.agent != excluded_agent && o.arrival <= arrival - 1 && arrival - 1 < o.departure && IsAt(o.agent, u, arrival);
+    });
+}
+
+void ConflictAvoidanceTable::Insert(const int agent, const SegmentedPath& p)
+{
+    const auto& segments = p.GetSegments();
+
+    for(size_t k = 0; k < segments.size(); k++)
+    {
+        const auto& s = segments[k];
+        cells[s.c].push_back({agent, s.arrival, k + 1 < segments.size() ? s.Departure() : INT_MAX});
+    }
+}
+
+void ConflictAvoidanceTable::Erase(const int agent, const SegmentedPath& p)
+{
+    for(const auto& s: p.GetSegments())
+    {
+        const auto iter = cells.find(s.c);
+        if(iter != cells.end())
+        {
+            auto& occupancies = iter->second;
+            occupancies.erase(std::remove_if(occupancies.begin(), occupancies.end(), [agent](const Occupancy& o){return o.agent == agent;}), occupancies.end());
+        }
+    }
+}
+
+bool ConflictAvoidanceTable::IsAt(const int agent, const Coordinate& c, const int t) const
+{
+    const auto iter = cells.find(c);
+    return iter != cells.end() && std::any_of(iter->second.begin(), iter->second.end(), [agent, t](const Occupancy& o)
+    {
+        return o.agent == agent && o.arrival <= t && t < o.departure;
+    });
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Coordinate.h"
+#include "SegmentedPath.h"
+#include "Types.h"
+#include <boost/unordered_map.hpp>
+#include <climits>
+#include <vector>
+
+// Occupancy of the coordinates by the paths of a CT node, used by the low-level planners to break ties in favour of fewer soft collisions.
+// Consecutive CT nodes share most of their paths, hence syncing the table to a node re-indexes only the paths which differ from the indexed ones.
+class ConflictAvoidanceTable
+{
+public:
+    ConflictAvoidanceTable() = default;
+
+    void Sync(const SharedSegmentedPaths& ps);
+    int Count(const Coordinate& c, int from, int to, int excluded_agent) const; // agents other than excluded_agent at c during [from, to]
+    int CountSwaps(const Coordinate& u, const Coordinate& v, int arrival, int excluded_agent) const; // agents moving v->u while u->v is traversed
+    inline unsigned long GetReindexed(void) const {return nreindexed;}
+
+private:
+    struct Occupancy
+    {
+        int agent;
+        int arrival;
+        int departure; // INT_MAX where the path ends
+    };
+
+    using Occupancies = std::vector<Occupancy>;
+
+    boost::unordered_map<Coordinate, Occupancies, Coordinate::Hasher> cells;
+    SharedSegmentedPaths indexed;
+    unsigned long nreindexed = 0;
+
+    void Insert(int agent, const SegmentedPath& p);
+    void Erase(int agent, const SegmentedPath& p);
+    bool IsAt(int agent, const Coordinate& c, int t) const;
+};
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "ConflictTable.h"
+#include "EdgeConflict.h"
+#include "VertexConflict.h"
+#include <algorithm>
+
+bool ConflictTable::Entry::IsEarlierThan(const Entry& other) const noexcept
+{
+    return timestep < other.timestep || (timestep == other.timestep && !is_edge_conflict && other.is_edge_conflict);
+}
+
+void ConflictTable::Build(const SharedSegmentedPaths& ps)
+{
+    pairs.clear();
+    count = 0;
+    const int k = ps.size();
+
+    for(int i = 0; i < k; i++)
+    {
+        if(!ps[i])
+            continue; // placeholder agent
+
+        for(int j = i + 1; j < k; j++)
+        {
+            if(ps[j])
+                Check(i, j, *ps[i], *ps[j]);
+        }
+    }
+}
+
+void ConflictTable::Update(const int agent_index, const SharedSegmentedPaths& ps)
+{
+    auto iter = pairs.begin();
+    while(iter != pairs.end())
+    {
+        const auto& [i, j] = iter->first;
+        if(i == agent_index || j == agent_index)
+        {
+            count -= iter->second.count;
+            iter = pairs.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    const int k = ps.size();
+    const auto& p = ps[agent_index];
+
+    for(int j = 0; p && j < k; j++)
+    {
+        if(j < agent_index && ps[j])
+            Check(j, agent_index, *ps[j], *p);
+        else if(j > agent_index && ps[j])
+            Check(agent_index, j, *p, *ps[j]);
+    }
+}
+
+IConflict* ConflictTable::Earliest(void) const
+{
+    const std::pair<int, int>* agents = nullptr;
+    const Entry* earliest = nullptr;
+
+    for(const auto& [key, entry]: pairs)
+    {
+        if(!earliest || entry.IsEarlierThan(*earliest) || (!earliest->IsEarlierThan(entry) && key < *agents)) // ties are broken by agents indices
+        {
+            agents = &key;
+            earliest = &entry;
+        }
+    }
+
+    return earliest ? Create(*agents, *earliest) : nullptr;
+}
+
+Conflicts ConflictTable::EarliestOfEachPair(void) const
+{
+    std::vector<std::tuple<const std::pair<int, int>*, const Entry*>> ordered;
+    ordered.reserve(pairs.size());
+
+    for(const auto& [key, entry]: pairs)
+    {
+        ordered.emplace_back(&key, &entry);
+    }
+
+    std::sort(ordered.begin(), ordered.end(), [](const auto& x, const auto& y)
+    {
+        const auto& [x_agents, x_entry] = x;
+        const auto& [y_agents, y_entry] = y;
+        return x_entry->IsEarlierThan(*y_entry) || (!y_entry->IsEarlierThan(*x_entry) && *x_agents < *y_agents);
+    });
+
+    Conflicts cs;
+    cs.reserve(ordered.size());
+    for(const auto& [agents, entry]: ordered)
+    {
+        cs.push_back(Create(*agents, *entry));
+    }
+
+    return cs;
+}
+
+IConflict* ConflictTable::EarliestBetween(const int i, const int j, const SegmentedPath& p1, const SegmentedPath& p2)
+{
+    const auto entry = Compare(p1, p2);
+    return entry.count > 0 ? Create({i, j}, entry) : nullptr;
+}
+
+IConflict* ConflictTable::Create(const std::pair<int, int>& agents, const Entry& entry)
+{
+    const std::vector<int> agents_indices{agents.first, agents.second};
+    if(entry.is_edge_conflict)
+        return new EdgeConflict(agents_indices, entry.timestep, entry.e1, entry.e2);
+
+    return new VertexConflict(agents_indices, entry.timestep, entry.c);
+}
+
+void ConflictTable::Check(const int i, const int j, const SegmentedPath& p1, const SegmentedPath& p2)
+{
+    auto entry = Compare(p1, p2);
+    if(entry.count > 0)
+    {
+        count += entry.count;
+        pairs[{i, j}] = entry;
+    }
+}
+
+ConflictTable::Entry ConflictTable::Compare(const SegmentedPath& p1, const SegmentedPath& p2)
+{
+    Entry out;
+    const auto& s1 = p1.GetSegments();
+    const auto& s2 = p2.GetSegments();
+    const int m1 = s1.size(), m2 = s2.size();
+
+    // vertex conflicts: both segment lists are ordered by time, an agent stays at its last coordinate once its path ends
+    int x = 0, y = 0;
+    while(x < m1 && y < m2)
+    {
+        const int d1 = (x + 1 < m1) ? s1[x].Departure() : INT_MAX;
+        const int d2 = (y + 1 < m2) ? s2[y].Departure() : INT_MAX;
+
+        if(s1[x].c == s2[y].c)
+        {
+            const int from = std::max(s1[x].arrival, s2[y].arrival), to = std::min(d1, d2);
+            if(from < to)
+            {
+                out.count += (to == INT_MAX) ? 1 : to - from;
+                if(from < out.timestep)
+                {
+                    out.timestep = from;
+                    out.is_edge_conflict = false;
+                    out.c = s1[x].c;
+                }
+            }
+        }
+
+        if(d1 <= d2)
+            x += 1;
+        if(d2 <= d1)
+            y += 1;
+    }
+
+    // edge conflicts: agents move only between consecutive segments, the move into segment k starts at s[k].arrival - 1
+    x = 1, y = 1;
+    while(x < m1 && y < m2)
+    {
+        const int t1 = s1[x].arrival - 1, t2 = s2[y].arrival - 1;
+
+        if(t1 == t2)
+        {
+            const Edge e1{s1[x - 1].c, s1[x].c}, e2{s2[y - 1].c, s2[y].c};
+            const auto crossing_edges = e1.GetCrossingEdges();
+
+            if(std::find(crossing_edges.begin(), crossing_edges.end(), e2) != crossing_edges.end())
+            {
+                out.count += 1;
+                if(t1 + 1 < out.timestep) // a vertex conflict at the same arrival timestep is preferred
+                {
+                    out.timestep = t1 + 1;
+                    out.is_edge_conflict = true;
+                    out.e1 = e1;
+                    out.e2 = e2;
+                }
+            }
+        }
+
+        if(t1 <= t2)
+            x += 1;
+        if(t2 <= t1)
+            y += 1;
+    }
+
+    return out;
+}
\ No newline at end of file
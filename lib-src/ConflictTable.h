@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Coordinate.h"
+#include "Edge.h"
+#include "IConflict.h"
+#include "SegmentedPath.h"
+#include "Types.h"
+#include <boost/unordered_map.hpp>
+#include <climits>
+#include <utility>
+
+// Pairwise conflicts between the paths of a CT node.
+// A child node inherits the table of its parent, only the pairs of its replanned agent are re-checked.
+class ConflictTable
+{
+public:
+    ConflictTable() = default;
+
+    void Build(const SharedSegmentedPaths& ps); // check all pairs of paths
+    void Update(int agent_index, const SharedSegmentedPaths& ps); // re-check the pairs of agent_index, whose path was replaced
+    IConflict* Earliest(void) const; // earliest conflict, vertex conflicts precede edge conflicts at the same timestep. Must be freed by the caller
+    Conflicts EarliestOfEachPair(void) const; // ordered as Earliest. Must be freed by the caller
+    inline bool IsEmpty(void) const {return pairs.empty();}
+    inline int Count(void) const {return count;} // total number of conflicts, over all pairs
+    static IConflict* EarliestBetween(int i, int j, const SegmentedPath& p1, const SegmentedPath& p2); // nullptr if the paths do not conflict. Must be freed by the caller
+
+private:
+    struct Entry
+    {
+        int count = 0;
+        int timestep = INT_MAX; // timestep of the earliest conflict, an edge conflict is timed by the arrival at the ends of its edges
+        bool is_edge_conflict = false;
+        Coordinate c{};
+        Edge e1{}, e2{};
+
+        bool IsEarlierThan(const Entry& other) const noexcept;
+    };
+
+    boost::unordered_map<std::pair<int, int>, Entry> pairs; // <i, j> s.t i < j -> conflicts between the paths of i and j, only conflicting pairs are kept
+    int count = 0;
+
+    void Check(int i, int j, const SegmentedPath& p1, const SegmentedPath& p2);
+    static IConflict* Create(const std::pair<int, int>& agents, const Entry& entry);
+    static Entry Compare(const SegmentedPath& p1, const SegmentedPath& p2);
+};
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "Constraint.h"
 #include <boost/unordered_map.hpp>
+#include <climits>
+#include <cstdlib>
 #include <string>
 
 Constraint::Constraint(int constrained_agent, const Coordinate& c, int timestep): constrained_agent(constrained_agent), c(c), timestep(timestep){}
@@ -7,9 +9,71 @@ Constraint::Constraint(int constrained_agent, const Coordinate& c, int timestep)
 Constraint::Constraint(int constrained_agent, int conflicted_agent, const Coordinate& c, int timestep): 
 constrained_agent(constrained_agent), conflicted_agent(conflicted_agent), c(c), timestep(timestep){}
 
+Constraint Constraint::Range(const int constrained_agent, const int conflicted_agent, const Coordinate& c, const int start, const int end)
+{
+    Constraint constraint(constrained_agent, conflicted_agent, c, start);
+    constraint.kind = Kind::Range;
+    constraint.end = end;
+    return constraint;
+}
+
+Constraint Constraint::Barrier(const int constrained_agent, const int conflicted_agent, const Coordinate& first, const Coordinate& last, const int timestep)
+{
+    Constraint constraint(constrained_agent, conflicted_agent, first, timestep);
+    constraint.kind = Kind::Barrier;
+    constraint.last = last;
+    return constraint;
+}
+
+Constraint Constraint::Length(const int constrained_agent, const int conflicted_agent, const Coordinate& goal, const int timestep)
+{
+    Constraint constraint(constrained_agent, conflicted_agent, goal, timestep);
+    constraint.kind = Kind::Length;
+    return constraint;
+}
+
+int Constraint::LastTimestep(void) const
+{
+    switch(kind)
+    {
+        case Kind::Range:
+            return end;
+        case Kind::Barrier:
+            return timestep + std::abs(last.row - c.row) + std::abs(last.column - c.column);
+        default:
+            return timestep;
+    }
+}
+
+void Constraint::Shift(const int dt)
+{
+    timestep += dt;
+    if(kind == Kind::Range && end != INT_MAX)
+    {
+        end += dt;
+    }
+}
+
 std::string Constraint::ToString(void) const
 {
-    return "Constraint on Agent" + std::to_string(constrained_agent) + ", on: " + c.ToString() + ", at: " + std::to_string(timestep) + ". Conflicted with Agent" + std::to_string(conflicted_agent);
+    std::string what;
+    switch(kind)
+    {
+        case Kind::Vertex:
+            what = "on: " + c.ToString() + ", at: " + std::to_string(timestep);
+            break;
+        case Kind::Range:
+            what = "on: " + c.ToString() + ", during: [" + std::to_string(timestep) + ", " + (end == INT_MAX ? "inf" : std::to_string(end)) + "]";
+            break;
+        case Kind::Barrier:
+            what = "on the barrier: " + c.ToString() + " - " + last.ToString() + ", from: " + std::to_string(timestep);
+            break;
+        case Kind::Length:
+            what = "ending at: " + c.ToString() + " not before: " + std::to_string(timestep + 1);
+            break;
+    }
+
+    return "Constraint on Agent" + std::to_string(constrained_agent) + ", " + what + ". Conflicted with Agent" + std::to_string(conflicted_agent);
 }
 
 std::ostream& operator << (std::ostream& out, const Constraint& c)
@@ -19,7 +83,7 @@ std::ostream& operator << (std::ostream& out, const Constraint& c)
 
 bool Constraint::operator == (const Constraint &other) const noexcept
 {
-    return constrained_agent == other.constrained_agent && c == other.c && timestep == other.timestep;
+    return kind == other.kind && constrained_agent == other.constrained_agent && c == other.c && timestep == other.timestep && end == other.end && last == other.last;
 }
 
 size_t Constraint::Hasher::operator()(const Constraint& c) const noexcept
@@ -29,6 +93,12 @@ size_t Constraint::Hasher::operator()(const Constraint& c) const noexcept
     boost::hash_combine(seed, c.constrained_agent);
     boost::hash_combine(seed, coordinate_hasher(c.c));
     boost::hash_combine(seed, c.timestep);
+    if(c.kind != Kind::Vertex)
+    {
+        boost::hash_combine(seed, (int)c.kind);
+        boost::hash_combine(seed, c.end);
+        boost::hash_combine(seed, coordinate_hasher(c.last));
+    }
     return seed;
 }
 
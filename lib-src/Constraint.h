@@ -3,16 +3,30 @@
 #include "Coordinate.h"
 #include <string>
 
+// A vertex constraint forbids c at timestep. The other kinds resolve a symmetric conflict at once:
+// a range constraint forbids c during [timestep, end], a barrier constraint forbids each coordinate of the straight line from c to last,
+// c at timestep and every next coordinate a timestep later, and a length constraint forbids the agent to reach its goal c for the last time before timestep + 1.
 struct Constraint
 {
+    enum class Kind {Vertex, Range, Barrier, Length};
+
+    Kind kind = Kind::Vertex;
     int constrained_agent = -1;
     int conflicted_agent = -1;
     Coordinate c{};
     int timestep = -1;
+    int end = -1; // last timestep of a range constraint, INT_MAX if it is never lifted
+    Coordinate last{}; // last coordinate of a barrier constraint
 
     Constraint(int constrained_agent, const Coordinate& c, int timestep);
     Constraint(int constrained_agent, int conflicted_agent, const Coordinate& c, int timestep);
 
+    static Constraint Range(int constrained_agent, int conflicted_agent, const Coordinate& c, int start, int end);
+    static Constraint Barrier(int constrained_agent, int conflicted_agent, const Coordinate& first, const Coordinate& last, int timestep);
+    static Constraint Length(int constrained_agent, int conflicted_agent, const Coordinate& goal, int timestep);
+
+    int LastTimestep(void) const; // latest timestep the constraint applies to
+    void Shift(int dt); // the same constraint, dt timesteps later
     std::string ToString(void) const;
 
     friend std::ostream& operator << (std::ostream& out, const Constraint&);
@@ -0,0 +1,19 @@
+#include "ConstraintChain.h"
+
+ConstraintChain::ConstraintChain(const Constraint& c, const Ptr& parent): c(c), parent(parent), key(KeyOf(parent) ^ Constraint::Hasher{}(c)), length(parent ? parent->length + 1 : 1){}
+
+ConstraintChain::Ptr ConstraintChain::Push(const Ptr& chain, const Constraint& c)
+{
+    return std::make_shared<const ConstraintChain>(c, chain);
+}
+
+bool ConstraintChain::Contains(const ConstraintChain* chain, const Constraint& c)
+{
+    for(; chain; chain = chain->parent.get())
+    {
+        if(chain->c == c)
+            return true;
+    }
+
+    return false;
+}
\ No newline at end of file
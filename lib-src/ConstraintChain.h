@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Constraint.h"
+#include <memory>
+
+// Persistent list of the constraints imposed on a single agent along a branch of the constraint tree.
+// A child CT node links its new constraint to the chain of its parent, hence chains are shared rather than copied.
+struct ConstraintChain
+{
+    using Ptr = std::shared_ptr<const ConstraintChain>;
+
+    Constraint c;
+    Ptr parent; // previous constraint imposed on the same agent
+    size_t key = 0; // xor of the hashes of all constraints on the chain
+    int length = 1;
+
+    ConstraintChain(const Constraint& c, const Ptr& parent);
+
+    static Ptr Push(const Ptr& chain, const Constraint& c);
+    static inline size_t KeyOf(const Ptr& chain) {return chain ? chain->key : 0;}
+    static bool Contains(const ConstraintChain* chain, const Constraint& c);
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "CorridorConflict.h"
+#include <cassert>
+#include <sstream>
+
+CorridorConflict::CorridorConflict(const std::vector<int>& agents_indices, const int timestep, const std::array<Coordinate, 2>& exits, const std::array<int, 2>& latest):
+IConflict(agents_indices, timestep), exits(exits), latest(latest){}
+
+std::string CorridorConflict::ToString(void) const
+{
+    std::stringstream ss;
+    ss << "Corridor-Conflict between: " << exits[1] << " and " << exits[0] << ", at: " << timestep << ". Agent" << agents_indices[0] << " until " << latest[0]
+       << ", Agent" << agents_indices[1] << " until " << latest[1] << '.';
+    return ss.str();
+}
+
+std::vector<Constraint> CorridorConflict::Resolve(void) const
+{
+    assert(agents_indices.size() == 2);
+    return {Constraint::Range(agents_indices[0], agents_indices[1], exits[0], 0, latest[0]), Constraint::Range(agents_indices[1], agents_indices[0], exits[1], 0, latest[1])};
+}
\ No newline at end of file
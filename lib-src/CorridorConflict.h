@@ -0,0 +1,19 @@
+#pragma once
+
+#include "IConflict.h"
+#include "Coordinate.h"
+#include <array>
+
+// Agents which traverse a corridor in opposite directions, one of them has to wait for the other. exits[k] is the end of the corridor
+// agents_indices[k] leaves it through, which it may not reach until latest[k]
+struct CorridorConflict: public IConflict
+{
+    const std::array<Coordinate, 2> exits;
+    const std::array<int, 2> latest;
+
+    CorridorConflict(const std::vector<int>& agents_indices, int timestep, const std::array<Coordinate, 2>& exits, const std::array<int, 2>& latest);
+    virtual ~CorridorConflict() = default;
+
+    std::string ToString(void) const override;
+    std::vector<Constraint> Resolve(void) const override;
+};
\ No newline at end of file
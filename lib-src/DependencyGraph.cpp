@@ -0,0 +1,138 @@
+#include "DependencyGraph.h"
+#include "DisjointSets.h"
+#include <algorithm>
+#include <functional>
+
+void DependencyGraph::AddEdge(const int i, const int j, const int weight)
+{
+    if(weight <= 0)
+        return;
+
+    const int u = vertices.try_emplace(i, vertices.size()).first->second;
+    const int v = vertices.try_emplace(j, vertices.size()).first->second;
+    edges.emplace_back(u, v, weight);
+}
+
+int DependencyGraph::MinimumVertexCover(void) const
+{
+    int cover = 0;
+
+    for(const auto& component: Components())
+    {
+        cover += Cover(component);
+    }
+
+    return cover;
+}
+
+std::vector<DependencyGraph::Component> DependencyGraph::Components(void) const
+{
+    DisjointSets ds(vertices.size());
+    for(const auto& [u, v, w]: edges)
+    {
+        ds.Union(u, v);
+    }
+
+    boost::unordered_map<int, int> ids; // representative -> component index
+    std::vector<Component> components;
+
+    for(const auto& e: edges)
+    {
+        const int representative = ds.FindSet(std::get<0>(e));
+        const auto [iter, is_inserted] = ids.try_emplace(representative, components.size());
+        if(is_inserted)
+            components.emplace_back();
+
+        components[iter->second].push_back(e);
+    }
+
+    return components;
+}
+
+int DependencyGraph::Cover(const Component& component)
+{
+    if(component.size() == 1)
+        return std::get<2>(component.front());
+
+    // relabel the vertices of the component by decreasing degree, so that the search branches on the most constrained vertices first
+    boost::unordered_map<int, int> degree;
+    for(const auto& [u, v, w]: component)
+    {
+        degree[u] += 1;
+        degree[v] += 1;
+    }
+
+    std::vector<int> order;
+    for(const auto& [u, d]: degree)
+        order.push_back(u);
+    std::sort(order.begin(), order.end(), [&degree](const int u, const int v){return degree[u] > degree[v] || (degree[u] == degree[v] && u < v);});
+
+    boost::unordered_map<int, int> rank;
+    for(int i = 0; i < (int)order.size(); i++)
+        rank[order[i]] = i;
+
+    const int n = order.size();
+    std::vector<std::vector<std::pair<int, int>>> earlier(n); // earlier[i] := <neighbor, weight> of i, s.t the neighbor is assigned before i
+    std::vector<int> max_weight(n, 0);
+
+    for(const auto& [u, v, w]: component)
+    {
+        const int i = std::max(rank[u], rank[v]), j = std::min(rank[u], rank[v]);
+        earlier[i].emplace_back(j, w);
+        max_weight[i] = std::max(max_weight[i], w);
+        max_weight[j] = std::max(max_weight[j], w);
+    }
+
+    // depth-first branch and bound over the values of x, in order. The least feasible value of x_i is forced by its already assigned neighbors
+    std::vector<int> x(n, 0);
+    int best = 0;
+    for(const int w: max_weight)
+        best += w;
+
+    unsigned long nassignments = 0;
+    std::function<void(int, int)> assign = [&](const int i, const int sum)
+    {
+        if(sum >= best || nassignments > SEARCH_BUDGET)
+            return;
+
+        if(i == n)
+        {
+            best = sum;
+            return;
+        }
+
+        int least = 0;
+        for(const auto& [j, w]: earlier[i])
+            least = std::max(least, w - x[j]);
+
+        for(int value = least; value <= max_weight[i]; value++)
+        {
+            nassignments += 1;
+            x[i] = value;
+            assign(i + 1, sum + value);
+        }
+    };
+    assign(0, 0);
+
+    // an interrupted search proves nothing, fall back to a bound which never overestimates
+    return nassignments > SEARCH_BUDGET ? MatchingBound(component) : best;
+}
+
+int DependencyGraph::MatchingBound(Component component)
+{
+    // the edges of a matching are covered independently of each other, hence the sum of their weights bounds the cover from below
+    std::sort(component.begin(), component.end(), [](const Edge& e1, const Edge& e2){return std::get<2>(e1) > std::get<2>(e2);});
+    boost::unordered_map<int, bool> is_matched;
+    int bound = 0;
+
+    for(const auto& [u, v, w]: component)
+    {
+        if(!is_matched[u] && !is_matched[v])
+        {
+            is_matched[u] = is_matched[v] = true;
+            bound += w;
+        }
+    }
+
+    return bound;
+}
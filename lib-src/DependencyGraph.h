@@ -0,0 +1,30 @@
+#pragma once
+
+#include <boost/unordered_map.hpp>
+#include <tuple>
+#include <vector>
+
+// Weighted graph over agents. An edge <i, j, w> states that any solution costs at least w more than the sum of the individual costs of i and j.
+// The minimum edge-weighted vertex cover of the graph is an admissible estimate of the cost increase of the whole solution.
+class DependencyGraph
+{
+public:
+    DependencyGraph() = default;
+
+    void AddEdge(int i, int j, int weight);
+    int MinimumVertexCover(void) const; // minimum sum of x_v over all vertices, s.t. x_i + x_j >= w for every edge <i, j, w>
+    inline bool IsEmpty(void) const {return edges.empty();}
+
+private:
+    using Edge = std::tuple<int, int, int>; // <u, v, weight> over compact vertices indices
+    using Component = std::vector<Edge>;
+
+    static constexpr unsigned long SEARCH_BUDGET = 1 << 16; // number of assignments tried per component before settling for a lower bound
+
+    boost::unordered_map<int, int> vertices; // agent index -> compact vertex index
+    std::vector<Edge> edges;
+
+    std::vector<Component> Components(void) const;
+    static int Cover(const Component& component);
+    static int MatchingBound(Component component);
+};
@@ -0,0 +1,155 @@
+#include "ECBS.h"
+#include "IConflict.h"
+#include "Timer.h"
+#include "Utils.h"
+#include <algorithm>
+#include <sstream>
+
+ECBS::ECBS(ILowLevelPlanner* llp, const float w): CBS(llp, Heuristic::None, false), w(w), open(), focal(){}
+
+CBS* ECBS::Fork(void) const
+{
+    return new ECBS(llp->Clone(), w);
+}
+
+bool ECBS::OpenComparator::operator() (const Entry* e1, const Entry* e2) const noexcept
+{
+    if(e1->n.lower_bound == e2->n.lower_bound)
+    {
+        return e1->n.cost > e2->n.cost;
+    }
+    return e1->n.lower_bound > e2->n.lower_bound;
+}
+
+bool ECBS::FocalComparator::operator() (const Entry* e1, const Entry* e2) const noexcept
+{
+    if(e1->n.nconflicts == e2->n.nconflicts)
+    {
+        return e1->n.cost > e2->n.cost;
+    }
+    return e1->n.nconflicts > e2->n.nconflicts;
+}
+
+std::tuple<bool, Paths, Constraints> ECBS::Search(const Graph& g, const Agents& as, const float timeout)
+{
+    CTNode goal;
+    Timer timer;
+    bool is_plan_found = false;
+    size_t lower_bound = 0;
+    llp->Invalidate();
+    auto root = Init(g, as);
+    if(root)
+    {
+        Push(new Entry(std::move(root)));
+    }
+
+    timer.Start(timeout);
+
+    while(!open.empty() && !timer.ExceedsRuntime() && !IsCancelled() && !is_plan_found)
+    {
+        lower_bound = open.top()->n.lower_bound;
+        Entry* e = Pop();
+
+        is_plan_found = e->n.conflicts.IsEmpty();
+        if(is_plan_found)
+        {
+            goal = std::move(e->n);
+        }
+        else
+        {
+            // conflicts are not classified, MDDs are meaningless over bounded-suboptimal paths
+            IConflict* c = e->n.conflicts.Earliest();
+            nsplit[(int)Cardinality::Unclassified] += 1;
+            for(auto&& s: Expand(e->n, c, g, as))
+            {
+                Push(new Entry(std::move(s)));
+            }
+            delete c;
+            BalanceHeaps(lower_bound);
+        }
+        delete e;
+    }
+
+    if(is_plan_found && lower_bound > 0)
+    {
+        max_suboptimality = std::max(max_suboptimality, (float)goal.cost / lower_bound);
+    }
+
+    Clear();
+    lookup.clear();
+
+    return {is_plan_found && !timer.ExceedsRuntime(), Materialize(goal.paths), Collect(goal.constraints)};
+}
+
+ECBS::Entry* ECBS::Pop(void)
+{
+    // the least lower bound drops when a node is pushed after a sibling of a higher one, nodes beyond the bound are dropped from focal
+    // until BalanceHeaps returns them
+    while(!focal.empty() && focal.top()->n.cost > w * open.top()->n.lower_bound)
+    {
+        focal.top()->in_focal = false;
+        focal.pop();
+    }
+
+    // the focal list may be empty only if the low-level planner is looser than w, the node of the least lower bound is expanded then
+    Entry* e = focal.empty() ? open.top() : focal.top();
+
+    if(e->in_focal)
+    {
+        focal.erase(e->focal_handler);
+        e->in_focal = false;
+    }
+    open.erase(e->open_handler);
+
+    return e;
+}
+
+void ECBS::Push(Entry* e)
+{
+    e->open_handler = open.push(e);
+
+    if(e->n.cost <= w * open.top()->n.lower_bound)
+    {
+        e->focal_handler = focal.push(e);
+        e->in_focal = true;
+        max_focal_size = std::max(max_focal_size, focal.size());
+    }
+}
+
+void ECBS::BalanceHeaps(const size_t lower_bound)
+{
+    // the least lower bound may only increase, hence the bound of focal is extended
+    if(!open.empty() && lower_bound < open.top()->n.lower_bound)
+    {
+        const auto new_bound = w * open.top()->n.lower_bound;
+
+        for(auto* e: open)
+        {
+            if(!e->in_focal && e->n.cost <= new_bound)
+            {
+                e->focal_handler = focal.push(e);
+                e->in_focal = true;
+            }
+        }
+        max_focal_size = std::max(max_focal_size, focal.size());
+    }
+}
+
+void ECBS::Clear(void)
+{
+    for(auto* e: open)
+    {
+        delete e;
+    }
+    open.clear();
+    focal.clear();
+}
+
+std::string ECBS::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << CBS::GetStats();
+    ss << "Max. focal list size: " << max_focal_size << '\n';
+    ss << "Max. solution cost to lower bound ratio: " << max_suboptimality << '\n';
+    return ss.str();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CBS.h"
+#include <boost/heap/fibonacci_heap.hpp>
+#include <utility>
+
+// Bounded-suboptimal CBS. Among the CT nodes which cost at most w times the least lower bound over open, the one with the fewest conflicts is
+// expanded. The lower bound of a node sums the f-min of the low-level searches of its agents, hence a solution costs at most w times the optimal
+// one, as long as the low-level planner is not looser than w.
+class ECBS: public CBS
+{
+public:
+    ECBS(ILowLevelPlanner* llp, float w=1.2);
+    virtual ~ECBS() = default;
+
+    inline std::string GetName(void) const override {return "ECBS(" + std::to_string(w).substr(0, 4) + ")+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    std::string GetStats(void) const override;
+
+protected:
+    struct Entry;
+    struct OpenComparator{bool operator() (const Entry* e1, const Entry* e2) const noexcept;};
+    struct FocalComparator{bool operator() (const Entry* e1, const Entry* e2) const noexcept;};
+
+    using OpenFibHeap = boost::heap::fibonacci_heap<Entry*, boost::heap::compare<OpenComparator>>;
+    using FocalFibHeap = boost::heap::fibonacci_heap<Entry*, boost::heap::compare<FocalComparator>>;
+
+    struct Entry
+    {
+        explicit Entry(CTNode&& n): n(std::move(n)){}
+
+        CTNode n;
+        bool in_focal = false;
+        OpenFibHeap::handle_type open_handler;
+        FocalFibHeap::handle_type focal_handler;
+    };
+
+    float w;
+    OpenFibHeap open;
+    FocalFibHeap focal;
+    size_t max_focal_size = 0;
+    float max_suboptimality = 0; // largest cost to lower bound ratio of a returned plan
+
+    std::tuple<bool, Paths, Constraints> Search(const Graph& g, const Agents& as, float timeout) override;
+    CBS* Fork(void) const override;
+    Entry* Pop(void);
+    void Push(Entry* e);
+    void BalanceHeaps(size_t lower_bound);
+    void Clear(void);
+};
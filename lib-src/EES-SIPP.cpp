@@ -1,5 +1,6 @@
 #include "EES-SIPP.h"
 #include "Agent.h"
+#include "ConflictAvoidanceTable.h"
 #include "Graph.h"
 #include "InformedHeuristic.h"
 #include "SafeIntervals.h"
@@ -13,6 +14,10 @@ bool EESSIPP::CleanupComparator::operator () (const Vertex* v1, const Vertex* v2
 {
     if(v1->f() == v2->f())
     {
+        if(v1->nconflicts != v2->nconflicts)
+        {
+            return v1->nconflicts > v2->nconflicts;
+        }
         if(v1->h == v2->h)
         {
             return v1->g <= v2->g;
@@ -26,6 +31,10 @@ bool EESSIPP::OpenComparator::operator () (const Vertex* v1, const Vertex* v2) c
 {
     if(v1->f_hat() == v2->f_hat())
     {
+        if(v1->nconflicts != v2->nconflicts)
+        {
+            return v1->nconflicts > v2->nconflicts;
+        }
         if(v1->h == v2->h)
         {
             return v1->g <= v2->g;
@@ -39,6 +48,10 @@ bool EESSIPP::FocalComparator::operator () (const Vertex* v1, const Vertex* v2)
 {
     if(v1->d_hat == v2->d_hat)
     {
+        if(v1->nconflicts != v2->nconflicts)
+        {
+            return v1->nconflicts > v2->nconflicts;
+        }
         if(v1->h == v2->h)
         {
             return v1->g <= v2->g;
@@ -51,7 +64,7 @@ bool EESSIPP::FocalComparator::operator () (const Vertex* v1, const Vertex* v2)
 Path EESSIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
 {
     nexpansions = 0;
-    GenerateStartVertex(a, si);
+    GenerateStartVertex(g, a, si);
     Vertex* v;
     float best_f_hat;
     bool is_goal_found = false;
@@ -67,13 +80,15 @@ Path EESSIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
         {
             for(Vertex* successor: Expand(v, g, a, si))
             {
-                Push(v, successor, g);
+                Push(v, successor, g, a);
             }
 
             BalanceHeaps(best_f_hat);
         }
     }
 
+    if(!is_goal_found)
+        lower_bound = INF;
     auto path = is_goal_found ? ReconstructPath(v) : Path{};;
     Clear();
     return path;
@@ -88,6 +103,7 @@ std::tuple<float, EESSIPP::Vertex*> EESSIPP::Pop()
 {
     float best_f = cleanup.top()->f();
     float best_f_hat = open.top()->f_hat();
+    lower_bound = best_f;
     Vertex* out = nullptr;
 
     if(focal.top()->f_hat() <= w * best_f)
@@ -129,15 +145,17 @@ std::tuple<float, EESSIPP::Vertex*> EESSIPP::Pop()
     return {best_f_hat, out};
 }
 
-void EESSIPP::Push(Vertex* parent, Vertex* successor, const Graph& g)
+void EESSIPP::Push(Vertex* parent, Vertex* successor, const Graph& g, const Agent& a)
 {
     if(parent != nullptr && successor != nullptr)
     {
         const auto successor_arriving_time = EarliestArrivingTime(parent, successor->s, g);
+        const int nconflicts = cat ? parent->nconflicts + CollisionsOf(parent, successor, successor_arriving_time, g, a) : 0;
 
-        if(successor_arriving_time < successor->g)
+        if(successor_arriving_time < successor->g || (successor_arriving_time == successor->g && nconflicts < successor->nconflicts))
         {
             successor->g = successor_arriving_time;
+            successor->nconflicts = nconflicts;
             successor->parent = parent;
             successor->d_hat = policy ? (successor->h + policy->GetPenalty({parent->s.c, successor->s.c}, g)) : successor->h;
 
@@ -197,20 +215,20 @@ bool EESSIPP::IsGoal(const Vertex* v, const Agent& a) const
     return v != nullptr && v->s.c == a.goal && v->s.i.IsUnbounded();
 }
 
-bool EESSIPP::GenerateStartVertex(const Agent& a, SafeIntervals& si)
+bool EESSIPP::GenerateStartVertex(const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Vertex* start = nullptr;
+    table.Reset(g.GetNumberOfIndices());
 
     const auto start_safe_interval = si.FirstSafeInterval(a.start, 0);
     if(start_safe_interval.IsIntersects(0) && !start_safe_interval.IsEmpty())
     {
-        start = new Vertex();
+        start = table.Create(g.IndexOf(a.start), 0); // the safe interval containing 0 is always the first one
         start->s = {a.start, start_safe_interval};
         start->g = 0;
         start->h = ih ? std::max((*ih)(a.start, a.goal), si.IntervalsOf(a.goal).rbegin()->start) : h(a.start, a.goal);
         start->h_hat = w * start->h;
         start->d_hat = start->h;
-        table[start->s] = start;
 
         start->cleanup_handler = cleanup.push(start);
         start->open_handler = open.push(start);
@@ -226,6 +244,8 @@ bool EESSIPP::GenerateStartVertex(const Agent& a, SafeIntervals& si)
 EESSIPP::Successors EESSIPP::Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Successors successors;
+    const int successor_index = g.IndexOf(successor_coordinate);
+    int ordinal = 0;
 
     for(const auto& successor_safe_interval: si.IntervalsOf(successor_coordinate))
     {
@@ -234,19 +254,14 @@ EESSIPP::Successors EESSIPP::Generate(Vertex* parent, const Coordinate& successo
 
         if(IsTransitionAllowed(parent, successor_state, successor_arriving_time))
         {
-            Vertex* successor;
-            if(IsGenerated(successor_state))
-            {
-                successor = table.at(successor_state);
-            }
-            else
+            Vertex* successor = table.Find(successor_index, ordinal);
+            if(!successor)
             {
-                successor = new Vertex();
+                successor = table.Create(successor_index, ordinal);
                 successor->s = successor_state;
                 successor->g = INF;
                 successor->h = ih ? std::max((*ih)(successor_coordinate, a.goal), si.IntervalsOf(a.goal).rbegin()->start - successor_arriving_time) : h(successor_coordinate, a.goal);
                 successor->h_hat = w * successor->h;
-                table[successor_state] = successor;
             }
 
             if(!successor->in_closed)
@@ -254,6 +269,8 @@ EESSIPP::Successors EESSIPP::Generate(Vertex* parent, const Coordinate& successo
                 successors.push_back(successor);
             }
         }
+
+        ordinal += 1;
     }
     
     return successors;
@@ -280,14 +297,20 @@ float EESSIPP::EarliestArrivingTime(const Vertex* parent, const State& successor
     return std::max(successor_state.i.start, successor_arriving_time);
 }
 
-bool EESSIPP::IsGenerated(const State& s) const
+bool EESSIPP::IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const
 {
-    return table.find(s) != table.end();
+    return (parent->s.c != successor_state.c) && successor_state.i.IsIntersects(arriving_time) && arriving_time <= parent->s.i.end;
 }
 
-bool EESSIPP::IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const
+int EESSIPP::CollisionsOf(const Vertex* parent, const Vertex* successor, const float arriving_time, const Graph& g, const Agent& a) const
 {
-    return (parent->s.c != successor_state.c) && successor_state.i.IsIntersects(arriving_time) && arriving_time <= parent->s.i.end;
+    // waiting at the parent, traversing the edge and arriving at the successor. An agent stays at its goal once it is reached
+    const int arrival = arriving_time;
+    const int departure = arriving_time - g.WeightOf({parent->s.c, successor->s.c});
+
+    return cat->Count(parent->s.c, parent->g + 1, departure, a.index)
+        + cat->CountSwaps(parent->s.c, successor->s.c, arrival, a.index)
+        + cat->Count(successor->s.c, arrival, IsGoal(successor, a) ? INT_MAX : arrival, a.index);
 }
 
 int EESSIPP::WaitingTimeAtParent(const Vertex* parent, const Vertex* successor) const
@@ -321,10 +344,6 @@ Path EESSIPP::ReconstructPath(const Vertex* goal) const
 
 void EESSIPP::Clear(void)
 {
-    for(auto& [state, vertex]: table)
-        delete(vertex);
-
-    table.clear();
     cleanup.clear();
     open.clear();
     focal.clear();
@@ -6,11 +6,13 @@
 #include "Types.h"
 #include "State.h"
 #include "SafeIntervals.h"
+#include "StateTable.h"
 #include "Utils.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include <boost/unordered_map.hpp>
 #include <vector>
 
+class ConflictAvoidanceTable;
 class IPolicy;
 class InformedHeuristic;
 
@@ -24,6 +26,9 @@ public:
     std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si) override;
     inline void Init(IPolicy* policy, const InformedHeuristic& ih) override{this->policy = policy; this->ih = &ih; nexpansions = 0;}
     inline std::string GetName(void) const override {return "EES-SIPP";}
+    inline ILowLevelPlanner* Clone(void) const override {return new EESSIPP(w, h);}
+    inline float GetLowerBound(void) const override {return lower_bound;}
+    inline void SetConflictAvoidanceTable(const ConflictAvoidanceTable* cat) override {this->cat = cat;}
 
 protected:
     struct Vertex;
@@ -35,7 +40,7 @@ protected:
     using OpenBalancedTree = boost::heap::fibonacci_heap<Vertex*, boost::heap::compare<OpenComparator>>;
     using FocalMinFibHeap = boost::heap::fibonacci_heap<Vertex*, boost::heap::compare<FocalComparator>>;
     using Successors = std::vector<Vertex*>;
-    using LookupTable = boost::unordered::unordered_map<State, Vertex*, State::Hasher, State::Equal>;
+    using LookupTable = StateTable<Vertex>;
     
     struct Vertex
     {
@@ -45,6 +50,7 @@ protected:
         float h = 0;      // admisibble heurisitc to cost-to-go 
         float h_hat = 0; // inadmissible heurisitc to cost-to-go
         float d_hat = 0; // estimate (potentialy inadmissible) to distance-to-go
+        int nconflicts = 0; // collisions with the paths of the conflict-avoidance table along the path to this node
         bool in_cleanup = false;
         bool in_focal = false;
         bool in_closed = false;
@@ -65,18 +71,20 @@ protected:
     FocalMinFibHeap focal;
     const IPolicy* policy;
     const InformedHeuristic* ih;
+    const ConflictAvoidanceTable* cat = nullptr;
     unsigned long nexpansions;
+    float lower_bound = INF; // least f over cleanup when the goal was popped
 
     std::tuple<float, Vertex*> Pop();
-    void Push(Vertex* parent, Vertex* successor, const Graph& g);
+    void Push(Vertex* parent, Vertex* successor, const Graph& g, const Agent& a);
     void BalanceHeaps(float f_hat_min);
     bool IsGoal(const Vertex* v, const Agent& a) const;
-    bool GenerateStartVertex(const Agent& a, SafeIntervals& si);
+    bool GenerateStartVertex(const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Expand(Vertex* current, const Graph& g, const Agent& a, SafeIntervals& si);
     float EarliestArrivingTime(const Vertex* parent, const State& successor_state, const Graph& g) const;
-    bool IsGenerated(const State& s) const;
     bool IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const;
+    int CollisionsOf(const Vertex* parent, const Vertex* successor, float arriving_time, const Graph& g, const Agent& a) const;
     int WaitingTimeAtParent(const Vertex* parent, const Vertex* successor) const;
     Path ReconstructPath(const Vertex* goal) const;
     void Clear(void);
@@ -38,7 +38,7 @@ bool FocalSIPP::FocalComparator::operator () (const Vertex* v1, const Vertex* v2
 Path FocalSIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
 {
     nexpansions = 0;
-    GenerateStartVertex(a, si);
+    GenerateStartVertex(g, a, si);
     Vertex* v;
     float fmin;
     bool is_goal_found = false;
@@ -61,6 +61,7 @@ Path FocalSIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
         }
     }
 
+    lower_bound = is_goal_found ? fmin : INF;
     auto path = is_goal_found ? ReconstructPath(v) : Path{};;
     Clear();
     return path;
@@ -146,19 +147,19 @@ bool FocalSIPP::IsGoal(const Vertex* v, const Agent& a) const
     return v != nullptr && v->s.c == a.goal && v->s.i.IsUnbounded();
 }
 
-bool FocalSIPP::GenerateStartVertex(const Agent& a, SafeIntervals& si)
+bool FocalSIPP::GenerateStartVertex(const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Vertex* start = nullptr;
+    table.Reset(g.GetNumberOfIndices());
 
     const auto start_safe_interval = si.FirstSafeInterval(a.start, 0);
     if(!start_safe_interval.IsEmpty())
     {
-        start = new Vertex();
+        start = table.Create(g.IndexOf(a.start), 0); // the safe interval containing 0 is always the first one
         start->s = {a.start, start_safe_interval};
         start->g = 0;
         start->h = ih ? std::max((*ih)(a.start, a.goal), si.IntervalsOf(a.goal).rbegin()->start) : h(a.start, a.goal);
         start->d_hat = start->h;
-        table[start->s] = start;
 
         start->open_handler = open.push(start);
         start->in_open = true;
@@ -173,6 +174,8 @@ bool FocalSIPP::GenerateStartVertex(const Agent& a, SafeIntervals& si)
 FocalSIPP::Successors FocalSIPP::Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Successors successors;
+    const int successor_index = g.IndexOf(successor_coordinate);
+    int ordinal = 0;
 
     for(const auto& successor_safe_interval: si.IntervalsOf(successor_coordinate))
     {
@@ -181,18 +184,13 @@ FocalSIPP::Successors FocalSIPP::Generate(Vertex* parent, const Coordinate& succ
 
         if(IsTransitionAllowed(parent, successor_state, successor_arriving_time))
         {
-            Vertex* successor;
-            if(IsGenerated(successor_state))
+            Vertex* successor = table.Find(successor_index, ordinal);
+            if(!successor)
             {
-                successor = table.at(successor_state);
-            }
-            else
-            {
-                successor = new Vertex();
+                successor = table.Create(successor_index, ordinal);
                 successor->s = successor_state;
                 successor->g = INF;
                 successor->h = ih ? std::max((*ih)(successor->s.c, a.goal), si.IntervalsOf(a.goal).rbegin()->start - successor_arriving_time) : h(successor->s.c, a.goal);
-                table[successor_state] = successor;
             }
 
             if(!successor->in_closed)
@@ -201,6 +199,8 @@ FocalSIPP::Successors FocalSIPP::Generate(Vertex* parent, const Coordinate& succ
             }
             
         }
+
+        ordinal += 1;
     }
     
     return successors;
@@ -227,11 +227,6 @@ float FocalSIPP::EarliestArrivingTime(const Vertex* parent, const State& success
     return std::max(successor_state.i.start, successor_arriving_time);
 }
 
-bool FocalSIPP::IsGenerated(const State& s) const
-{
-    return table.find(s) != table.end();
-}
-
 bool FocalSIPP::IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const
 {
     return parent->s.c != successor_state.c && successor_state.i.IsIntersects(arriving_time) && arriving_time <= parent->s.i.end;
@@ -267,10 +262,6 @@ Path FocalSIPP::ReconstructPath(const Vertex* goal) const
 
 void FocalSIPP::Clear(void)
 {
-    for(auto& [state, vertex]: table)
-        delete(vertex);
-
-    table.clear();
     open.clear();
     focal.clear();
 }
@@ -7,6 +7,7 @@
 #include "Types.h"
 #include "State.h"
 #include "SafeIntervals.h"
+#include "StateTable.h"
 #include "Utils.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include <boost/unordered_map.hpp>
@@ -24,6 +25,8 @@ public:
     std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si) override;   
     inline void Init(IPolicy* policy, const InformedHeuristic& ih) override {this->policy = policy; this->ih = &ih; nexpansions = 0;}
     inline std::string GetName(void) const override {return "Focal-SIPP";}
+    inline ILowLevelPlanner* Clone(void) const override {return new FocalSIPP(w, h);}
+    inline float GetLowerBound(void) const override {return lower_bound;}
 
 protected:
     struct Vertex;
@@ -33,7 +36,7 @@ protected:
     using OpenBalancedTree = boost::heap::fibonacci_heap<Vertex*, boost::heap::compare<OpenComparator>>;
     using FocalMinFibHeap = boost::heap::fibonacci_heap<Vertex*, boost::heap::compare<FocalComparator>>;
     using Successors = std::vector<Vertex*>;
-    using LookupTable = boost::unordered::unordered_map<State, Vertex*, State::Hasher, State::Equal>;
+    using LookupTable = StateTable<Vertex>;
     
     struct Vertex
     {
@@ -60,16 +63,16 @@ protected:
     const IPolicy* policy;
     const InformedHeuristic* ih;
     unsigned long nexpansions;
+    float lower_bound = INF; // f-min when the goal was popped
 
     std::tuple<float, Vertex*> Pop();
     void Push(Vertex* parent, Vertex* successor, const Graph& g);
     void BalanceHeaps(float fmin);
     bool IsGoal(const Vertex* v, const Agent& a) const;
-    bool GenerateStartVertex(const Agent& a, SafeIntervals& si);
+    bool GenerateStartVertex(const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Expand(Vertex* current, const Graph& g, const Agent& a, SafeIntervals& si);
     float EarliestArrivingTime(const Vertex* parent, const State& successor_state, const Graph& g) const;
-    bool IsGenerated(const State& s) const;
     bool IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const;
     int WaitingTimeAtParent(const Vertex* parent, const Vertex* successor) const;
     Path ReconstructPath(const Vertex* goal) const;
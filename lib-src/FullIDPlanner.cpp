@@ -3,9 +3,32 @@
 #include "IHighLevelPlanner.h"
 #include "IPlanner.h"
 #include "IPolicy.h"
+#include "Timer.h"
 
 FullIDPlanner::FullIDPlanner(IPolicy* policy, IHighLevelPlanner* ihlp): FullPlanner(policy, ihlp){}
 
+PlanResult FullIDPlanner::InitialPlan(const Graph& g, const Agents& as, const float timeout)
+{
+    // independence detection from scratch: every agent is a group of its own and all of them are affected. Groups are merged only once their
+    // plans conflict, and the final partition is kept by the high-level planner for later replans
+    Timer timer;
+    Paths plans(as.size());
+    AgentsIndicesSet all;
+    timer.Start(timeout);
+
+    for(const auto& a: as)
+    {
+        if(!Agent::IsPlaceholderAgent(a))
+        {
+            all.insert(a.index);
+        }
+    }
+
+    auto [is_planning_succeed, high_level_nexpansions] = ihlp->Replan(g, as, plans, all, timeout, 0);
+
+    return {is_planning_succeed, is_planning_succeed ? plans : Paths{}, high_level_nexpansions, timer.Stop()};
+}
+
 std::tuple<bool, bool, unsigned long> FullIDPlanner::Replan(const Graph& g, const Agents& as, Paths& ongoing_plans, const AgentsIndicesSet& affected, float runtime, const int current_timestep){
     bool is_replanning_succeed = true, is_replanning_occurred = false;
     unsigned long high_level_nexpansions = 0;
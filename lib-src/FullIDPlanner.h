@@ -20,5 +20,6 @@ public:
     inline std::string GetName(void) const override {return "Full+ID+" + ihlp->GetName() + "+" + policy->GetName();}
 
 protected:
+    PlanResult InitialPlan(const Graph& g, const Agents& as, float timeout) override;
     std::tuple<bool, bool, unsigned long> Replan(const Graph& g, const Agents& as, Paths& ongoing_plans, const AgentsIndicesSet& affected, float runtime, int current_timestep) override;
 };
\ No newline at end of file
@@ -19,7 +19,8 @@ ScenarioResult FullPlanner::Plan(const Snapshot& snap, const Agents& src, const
     EdgeSet observed_maybe_open_edge, observed_maybe_blocked_edge;
     EdgeSet new_observed_maybe_open_edge, new_observed_maybe_blocked_edge;
     Agents as(src);
-    Paths realized(src.size());
+    TrajectoryBuffer realized(src.size());
+    PlanBuffer ongoing;
     Paths plans;
     int timestep = 0;
     float runtime;
@@ -32,13 +33,15 @@ ScenarioResult FullPlanner::Plan(const Snapshot& snap, const Agents& src, const
     
     timer.Start(timeout);
     
-    std::tie(is_planning_succeed, plans, high_level_nexpansions, runtime) = ihlp->Plan(g, as, timer.GetRemainingRuntime());
+    std::tie(is_planning_succeed, plans, high_level_nexpansions, runtime) = InitialPlan(g, as, timer.GetRemainingRuntime());
     total_nexpansions += high_level_nexpansions;
 
     #ifdef LOG
         LogPlan(plans);
     #endif
 
+    ongoing.Swap(std::move(plans));
+
     while(is_planning_succeed && !timer.ExceedsRuntime() && !Validator::AreAllAgentsReachedTheirGoals(as, realized))
     {
         std::tie(new_observed_maybe_open_edge, new_observed_maybe_blocked_edge) = Observe(as, g, snap, observed_maybe_open_edge, observed_maybe_blocked_edge);
@@ -51,6 +54,7 @@ ScenarioResult FullPlanner::Plan(const Snapshot& snap, const Agents& src, const
 
             UpdateGraph(g, new_observed_maybe_open_edge, new_observed_maybe_blocked_edge);
             policy->Update(new_observed_maybe_open_edge, new_observed_maybe_blocked_edge);
+            plans = ongoing.Remaining();
             std::tie(is_planning_succeed, is_replanning_occurred, high_level_nexpansions) = Replan(g, as, plans,FindAffectedAgents(g, plans, new_observed_maybe_open_edge, new_observed_maybe_blocked_edge, ih), timer.GetRemainingRuntime(), timestep);
             total_nexpansions += high_level_nexpansions;
             if(is_replanning_occurred)
@@ -61,11 +65,13 @@ ScenarioResult FullPlanner::Plan(const Snapshot& snap, const Agents& src, const
             #ifdef LOG
                 LogPlan(plans);
             #endif
+
+            ongoing.Swap(std::move(plans));
         }
 
         if(is_planning_succeed)
         {
-            Step(as, realized, plans);
+            Step(as, realized, ongoing);
 
             #ifdef LOG
                 LogStep(realized, timestep);
@@ -77,7 +83,12 @@ ScenarioResult FullPlanner::Plan(const Snapshot& snap, const Agents& src, const
 
     is_planning_succeed = is_planning_succeed && !timer.ExceedsRuntime();
 
-    return {is_planning_succeed, is_planning_succeed ? Prune(realized): Paths(), timer.Stop(), replans, total_nexpansions};
+    return {is_planning_succeed, is_planning_succeed ? Prune(realized.ToPaths()): Paths(), timer.Stop(), replans, total_nexpansions};
+}
+
+PlanResult FullPlanner::InitialPlan(const Graph& g, const Agents& as, const float timeout)
+{
+    return ihlp->Plan(g, as, timeout);
 }
 
 std::tuple<bool, bool, unsigned long> FullPlanner::Replan(const Graph& g, const Agents& as, Paths& ongoing_plans, const AgentsIndicesSet& affected, float runtime, int current_timestep)
@@ -14,9 +14,11 @@ public:
 
     ScenarioResult Plan(const Snapshot& snap, const Agents& src, const InformedHeuristic& ih, float timeout) override;
     virtual inline std::string GetName(void) const override {return "Full+" + ihlp->GetName() + "+" + policy->GetName();}
+    inline std::string GetStats(void) const override {return ihlp->GetStats();}
 
 protected:
     IHighLevelPlanner* ihlp;
 
+    virtual PlanResult InitialPlan(const Graph& g, const Agents& as, float timeout);
     virtual std::tuple<bool, bool, unsigned long> Replan(const Graph& g, const Agents& as, Paths& ongoing_plans, const AgentsIndicesSet& affected, float runtime, int current_timestep);
 };
\ No newline at end of file
@@ -2,19 +2,24 @@
 #include "Edge.h"
 #include "Types.h"
 #include <utility>
+#include <algorithm>
 
-Graph::Graph(): V(), E(), W(), Adj(){}
+Graph::Graph(): V(), E(), W(), Adj(), RevAdj(){}
 
-Graph::Graph(const CoordinateSet& V, const EdgeSet& E): V(V), E(E), W(), Adj(BuildAdjacencyList(E))
+Graph::Graph(const CoordinateSet& V, const EdgeSet& E): V(V), E(E), W(), Adj(BuildAdjacencyList(E)), RevAdj(BuildReverseAdjacencyList(E))
 {
     InitializeWeights();
+    InitializeDimensions();
 }
 
-Graph::Graph(const CoordinateSet& V, const EdgeSet& E, const EdgeWeightFunction& W): V(V), E(E), W(W), Adj(BuildAdjacencyList(E)){}
+Graph::Graph(const CoordinateSet& V, const EdgeSet& E, const EdgeWeightFunction& W): V(V), E(E), W(W), Adj(BuildAdjacencyList(E)), RevAdj(BuildReverseAdjacencyList(E))
+{
+    InitializeDimensions();
+}
 
-Graph::Graph(const Graph& other): V(other.V), E(other.E), W(other.W), Adj(other.Adj){}
+Graph::Graph(const Graph& other): V(other.V), E(other.E), W(other.W), Adj(other.Adj), RevAdj(other.RevAdj), nrows(other.nrows), ncolumns(other.ncolumns){}
 
-Graph::Graph(Graph&& other): V(std::forward<CoordinateSet>(other.V)), E(std::forward<EdgeSet>(other.E)), W(other.W), Adj(std::forward<AdjacencyList>(other.Adj)){}
+Graph::Graph(Graph&& other): V(std::forward<CoordinateSet>(other.V)), E(std::forward<EdgeSet>(other.E)), W(other.W), Adj(std::forward<AdjacencyList>(other.Adj)), RevAdj(std::forward<AdjacencyList>(other.RevAdj)), nrows(other.nrows), ncolumns(other.ncolumns){}
 
 AdjacencyList Graph::BuildAdjacencyList(const EdgeSet& E) const
 {
@@ -30,23 +35,50 @@ AdjacencyList Graph::BuildAdjacencyList(const EdgeSet& E) const
     return adj;
 }
 
+AdjacencyList Graph::BuildReverseAdjacencyList(const EdgeSet& E) const
+{
+    AdjacencyList rev_adj;
+
+    for(const auto& e: E)
+        rev_adj[e.destination].insert(e.source);
+    
+    return rev_adj;
+}
+
 void Graph::InitializeWeights(void)
 {
     for(const auto& e: E)
         W[e] = EDGE_UNIT_COST_WEIGHT;
 }
 
-CoordinateSet Graph::SuccessorsOf(const Coordinate& u) const
+void Graph::InitializeDimensions(void)
 {
-    CoordinateSet s;
+    nrows = ncolumns = 0;
 
-    if(Adj.find(u) != Adj.end())
+    for(const auto& v: V)
     {
-        for(const auto& v: Adj.at(u))
-            s.insert(v);
+        nrows = std::max(nrows, v.row + 1);
+        ncolumns = std::max(ncolumns, v.column + 1);
     }
+}
+
+CoordinateSet Graph::SuccessorsOf(const Coordinate& u) const
+{
+    auto iter = Adj.find(u);
+    return iter != Adj.end() ? iter->second : CoordinateSet{};
+}
 
-    return s;
+const CoordinateSet& Graph::AdjacentOf(const Coordinate& u) const
+{
+    static const CoordinateSet none;
+    auto iter = Adj.find(u);
+    return iter != Adj.end() ? iter->second : none;
+}
+
+CoordinateSet Graph::PredecessorsOf(const Coordinate& v) const
+{
+    auto iter = RevAdj.find(v);
+    return iter != RevAdj.end() ? iter->second : CoordinateSet{};
 }
 
 float Graph::WeightOf(const Edge& e) const
@@ -58,6 +90,7 @@ void Graph::RemoveEdge(const Edge& e)
 {
     E.erase(e);
     Adj[e.source].erase(e.destination);
+    RevAdj[e.destination].erase(e.source);
     W.erase(e);
 }
 
@@ -65,6 +98,7 @@ void Graph::AddEdge(const Edge& e)
 {
     E.insert(e);
     Adj[e.source].insert(e.destination);
+    RevAdj[e.destination].insert(e.source);
     W[e] = EDGE_UNIT_COST_WEIGHT;
 }
 
@@ -82,6 +116,9 @@ Graph& Graph::operator = (const Graph& other)
         E = other.E;
         W = other.W;
         Adj = other.Adj;
+        RevAdj = other.RevAdj;
+        nrows = other.nrows;
+        ncolumns = other.ncolumns;
     }
     return *this;
 }
@@ -94,6 +131,9 @@ Graph& Graph::operator = (Graph&& other)
         E = std::forward<EdgeSet>(other.E);
         W = std::forward<EdgeWeightFunction>(other.W);
         Adj = std::forward<AdjacencyList>(other.Adj);
+        RevAdj = std::forward<AdjacencyList>(other.RevAdj);
+        nrows = other.nrows;
+        ncolumns = other.ncolumns;
     }
     return *this;
 }
\ No newline at end of file
@@ -14,12 +14,18 @@ public:
     virtual ~Graph() = default;
 
     CoordinateSet SuccessorsOf(const Coordinate& u) const;
+    const CoordinateSet& AdjacentOf(const Coordinate& u) const; // successors of u, without copying
+    CoordinateSet PredecessorsOf(const Coordinate& v) const;
     float WeightOf(const Edge& e) const;
     void RemoveEdge(const Edge& e);
     void AddEdge(const Edge& e);
     void UpdateEdgeWeight(const Edge& e, float new_weight);
     inline const EdgeSet& GetEdges(void) const {return E;}
     inline const CoordinateSet& GetVertices(void) const {return V;}
+    inline const EdgeWeightFunction& GetWeights(void) const {return W;}
+    inline int IndexOf(const Coordinate& c) const {return c.row * ncolumns + c.column;} // dense row-major index of a vertex, in [0, GetNumberOfIndices())
+    inline int GetNumberOfIndices(void) const {return nrows * ncolumns;}
+    inline int GetNumberOfColumns(void) const {return ncolumns;}
 
     bool operator == (const Graph& other) const noexcept{return V == other.V && E == other.E && W == other.W && Adj == other.Adj;}
     Graph& operator = (const Graph& other);
@@ -30,7 +36,11 @@ protected:
     EdgeSet E;
     EdgeWeightFunction W;
     AdjacencyList Adj;
+    AdjacencyList RevAdj; // RevAdj[v] := {u | (u, v) in E}
+    int nrows = 0, ncolumns = 0;
     
     AdjacencyList BuildAdjacencyList(const EdgeSet& E) const;
+    AdjacencyList BuildReverseAdjacencyList(const EdgeSet& E) const;
+    void InitializeDimensions(void);
     void InitializeWeights(void);
 };
\ No newline at end of file
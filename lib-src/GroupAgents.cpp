@@ -0,0 +1,35 @@
+#include "GroupAgents.h"
+#include <algorithm>
+
+GroupAgents::GroupAgents(const AgentsIndicesSet& group, const Agents& all): agents(), global(group.begin(), group.end())
+{
+    std::sort(global.begin(), global.end());
+    agents.reserve(global.size());
+
+    for(int i = 0; i < (int)global.size(); i++)
+    {
+        agents.emplace_back(all[global[i]].start, all[global[i]].goal, i);
+    }
+}
+
+void GroupAgents::Scatter(Paths&& local_paths, Paths& global_paths) const
+{
+    for(int i = 0; i < Size(); i++)
+    {
+        global_paths[global[i]] = std::move(local_paths[i]);
+    }
+}
+
+Constraints GroupAgents::Globalize(const Constraints& local_constraints) const
+{
+    Constraints cs;
+
+    for(auto c: local_constraints)
+    {
+        c.constrained_agent = global[c.constrained_agent];
+        c.conflicted_agent = c.conflicted_agent >= 0 ? global[c.conflicted_agent] : -1;
+        cs.insert(c);
+    }
+
+    return cs;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Types.h"
+#include <vector>
+
+// Agents of a group re-indexed by 0..n-1, in the order of their global indices, together with the mapping back to the global indices.
+// Planning for the group with its local agents costs in proportion to the size of the group rather than to the number of all agents.
+class GroupAgents
+{
+public:
+    GroupAgents(const AgentsIndicesSet& group, const Agents& all);
+
+    inline const Agents& Local(void) const {return agents;}
+    inline int Size(void) const {return agents.size();}
+    inline int GlobalOf(const int local_index) const {return global[local_index];}
+    void Scatter(Paths&& local_paths, Paths& global_paths) const; // global_paths[GlobalOf(i)] := local_paths[i]
+    Constraints Globalize(const Constraints& local_constraints) const;
+
+private:
+    Agents agents; // agents[i].index == i
+    std::vector<int> global; // global[i] := global index of agents[i]
+};
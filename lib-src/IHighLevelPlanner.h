@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Types.h"
+#include <atomic>
 
 class Graph;
 class Snapshot;
@@ -15,4 +16,13 @@ public:
     virtual std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) = 0;
     virtual void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) = 0;
     virtual std::string GetName(void) const = 0;
+    virtual std::string GetStats(void) const {return "";}
+
+    // cooperative cancellation, planners poll the flag along with their deadline and give up once it is raised
+    inline void SetCancellationFlag(const std::atomic<bool>* flag) {is_cancelled = flag;}
+
+protected:
+    const std::atomic<bool>* is_cancelled = nullptr;
+
+    inline bool IsCancelled(void) const {return is_cancelled && is_cancelled->load(std::memory_order_relaxed);}
 };
\ No newline at end of file
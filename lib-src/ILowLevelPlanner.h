@@ -1,7 +1,9 @@
 #pragma once
 
+#include "Constants.h"
 #include "Types.h"
 
+class ConflictAvoidanceTable;
 class Graph;
 class Snapshot;
 class SafeIntervals;
@@ -16,4 +18,20 @@ public:
     virtual std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si) = 0;
     virtual void Init(IPolicy* policy, const InformedHeuristic& ih) = 0;
     virtual std::string GetName(void) const = 0;
+    virtual ILowLevelPlanner* Clone(void) const = 0; // planner of the same configuration, which must be initialized before use. Must be freed by the caller
+
+    // Incremental search. key identifies the constraints si was built from; a later search for the same agent under one more constraint may Resume it.
+    // Planners which do not support it search from scratch.
+    virtual std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si, size_t /*key*/) {return Search(g, a, si);}
+    virtual std::tuple<Path, unsigned long> Resume(const Graph& g, const Agent& a, SafeIntervals& si, size_t key, size_t /*parent_key*/, const Constraint& /*c*/) {return Search(g, a, si, key);}
+    virtual void Invalidate(void) {} // drop kept searches, must be called whenever the graph changes
+    virtual std::string GetStats(void) const {return "";}
+
+    // f-min of the last search, no path which satisfies its constraints costs less. Planners which return optimal paths keep the default,
+    // the cost of their path is the bound
+    virtual float GetLowerBound(void) const {return INF;}
+
+    // paths of the other agents, ties between equally promising nodes are broken in favour of fewer collisions with them. nullptr disables it.
+    // Planners which do not support it ignore the table
+    virtual void SetConflictAvoidanceTable(const ConflictAvoidanceTable* /*cat*/) {}
 };  
\ No newline at end of file
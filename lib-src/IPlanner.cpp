@@ -39,17 +39,17 @@ std::tuple<EdgeSet, EdgeSet> IPlanner::Observe(const Agents& as, const Graph& g,
     return {new_observed_maybe_open_edge, new_observed_maybe_blocked_edge};
 }
 
-void IPlanner::Step(Agents& as, Paths& realized, Paths& planned) const
+void IPlanner::Step(Agents& as, TrajectoryBuffer& realized, PlanBuffer& planned) const
 {
+    // track agents current location
+    realized.Record(planned);
+    // if the agent is currently at its goal, its planned to stay there (i.e, wait) until all agents reach their goals.
+    planned.Step();
+
     for(int i = 0; i < as.size(); i++)
     {
-        // track agent current location
-        realized[i].push_back(planned[i].front()); 
-        // if the agent is currently at its goal, its planned to stay there (i.e, wait) until all agents reach their goals.
-        planned[i] = (planned[i].size() > 1) ? Path(std::move_iterator(std::next(planned[i].begin())), std::move_iterator(planned[i].end())) : Path{planned[i].back()};
-        // set the rest of the planned path
         // move the agent to its next planned coordinate
-        as[i].start = planned[i].front();
+        as[i].start = planned.CurrentOf(i);
     }
 }
 
@@ -176,15 +176,15 @@ void IPlanner::LogPlan(const Paths& planned_paths)
     log << log_lines_delimiter;
 }
 
-void IPlanner::LogStep(const Paths& realized_paths, const int timestep)
+void IPlanner::LogStep(const TrajectoryBuffer& realized, const int timestep)
 {
     log << log_steps_title << log_lines_delimiter;
 
     log << "#step" << log_lines_delimiter << std::to_string(timestep);
 
-    for(const auto& p: realized_paths)
+    for(int i = 0; i < realized.GetNumberOfAgents(); i++)
     {
-        log << log_path_coordinates_delimiter << p.back();
+        log << log_path_coordinates_delimiter << realized.Back(i);
     }
         
     log << log_lines_delimiter;
@@ -5,6 +5,8 @@
 #include "IPolicy.h"
 #include "Types.h"
 #include "Snapshot.h"
+#include "PlanBuffer.h"
+#include "TrajectoryBuffer.h"
 #include <string>
 #include <fstream>
 
@@ -20,6 +22,7 @@ public:
 
     virtual ScenarioResult Plan(const Snapshot& snap, const Agents& src, const InformedHeuristic& ih, float timeout) = 0;
     virtual std::string GetName(void) const = 0;
+    virtual std::string GetStats(void) const = 0;
 
     void LogMap(const Map&);
     void LogAgents(const Agents&);
@@ -47,7 +50,7 @@ protected:
     static constexpr auto log_file_suffix = "log";
 
     std::tuple<EdgeSet, EdgeSet> Observe(const Agents& as, const Graph& g, const Snapshot& snap, EdgeSet& observed_maybe_open_edge, EdgeSet& observed_maybe_blocked_edge) const;
-    void Step(Agents& as, Paths& realized, Paths& planned) const;
+    void Step(Agents& as, TrajectoryBuffer& realized, PlanBuffer& planned) const;
     void UpdateGraph(Graph& g, const EdgeSet& new_observed_maybe_open_edge, const EdgeSet& new_observed_maybe_blocked_edge) const;
     Paths Prune(const Paths& ps) const;
 
@@ -56,7 +59,7 @@ protected:
     AgentsIndicesSet FindAffectedByNewObservedOpenEdge(const Graph& g, const Paths& planned_paths, const EdgeSet& new_observed_maybe_blocked_edge, const InformedHeuristic& ih);
 
     void LogPlan(const Paths& planned_paths);
-    void LogStep(const Paths& realized_paths, int timestep);
+    void LogStep(const TrajectoryBuffer& realized, int timestep);
     void LogObservations(const EdgeSet& new_observed_maybe_open_edges, const EdgeSet& new_observed_maybe_blocked_edges, int timestep, int agent_index = 0);
     std::string ObservationToString(const Edge& edge, bool is_maybe_open, int timestep, int agent_index);
     void LogMaybeEdges(const EdgeSet& maybe_edges, const std::string& title);
@@ -0,0 +1,269 @@
+#include "Incremental-SIPP.h"
+#include "SafeIntervals.h"
+#include "Graph.h"
+#include <iterator>
+#include <sstream>
+#include <cassert>
+#include <utility>
+
+IncrementalSIPP::IncrementalSIPP(const size_t capacity): capacity(capacity), trees(), keys(){}
+
+std::tuple<Path, unsigned long> IncrementalSIPP::Search(const Graph& g, const Agent& a, SafeIntervals& si, const size_t key)
+{
+    auto root = Init(g, a, si);
+    nexpansions = 0;
+    MinFibHeap open;
+    if(root)
+    {
+        root->handler = open.push(root);
+        root->in_open = true;
+    }
+
+    const Vertex* goal = BestFirstSearch(open, g, a, si);
+    Keep(KeyOf(a, key), goal);
+
+    nfresh += 1;
+    fresh_nexpansions += nexpansions;
+
+    return {goal ? ReconstructPath(goal) : Path{}, nexpansions};
+}
+
+std::tuple<Path, unsigned long> IncrementalSIPP::Resume(const Graph& g, const Agent& a, SafeIntervals& si, const size_t key, const size_t parent_key, const Constraint& c)
+{
+    auto iter = trees.find(KeyOf(a, parent_key));
+    if(iter == trees.end())
+    {
+        return Search(g, a, si, key);
+    }
+
+    if(iter->second.goal < 0) // an additional constraint can not turn an unsolvable search into a solvable one
+    {
+        nresumed += 1;
+        return {Path{}, 0};
+    }
+
+    nexpansions = 0;
+    MinFibHeap open;
+    auto [is_restored, goal] = Restore(iter->second, open, g, a, si, c);
+
+    if(!is_restored)
+    {
+        return Search(g, a, si, key);
+    }
+
+    if(!goal)
+    {
+        goal = BestFirstSearch(open, g, a, si);
+    }
+
+    Keep(KeyOf(a, key), goal);
+
+    nresumed += 1;
+    resumed_nexpansions += nexpansions;
+
+    auto path = goal ? ReconstructPath(goal) : Path{};
+
+    #ifdef VERIFY_INCREMENTAL_SEARCH
+        // a resumed tree, whether kept by a fresh search or by a resumed one, must yield a path as short as a search from scratch
+        const auto expansions = nexpansions;
+        assert(SIPP::Plan(g, a, si).size() == path.size());
+        nexpansions = expansions;
+    #endif
+
+    return {std::move(path), nexpansions};
+}
+
+std::tuple<bool, IncrementalSIPP::Vertex*> IncrementalSIPP::Restore(const SearchTree& tree, MinFibHeap& open, const Graph& g, const Agent& a, SafeIntervals& si, const Constraint& c)
+{
+    const auto& nodes = tree.nodes;
+    const int n = nodes.size();
+
+    // a constraint on the goal may shift its last safe interval, which changes the heuristic value of every node.
+    // Constraints over many timesteps or coordinates are not repaired, they would invalidate most of the tree anyway
+    if(c.c == a.goal || c.kind != Constraint::Kind::Vertex)
+    {
+        return {false, nullptr};
+    }
+
+    // invalidate the vertex whose safe interval was split by c, and all of its descendants
+    std::vector<std::vector<int>> children(n);
+    std::vector<bool> removed(n, false);
+    std::vector<int> stack;
+
+    for(int i = 0; i < n; i++)
+    {
+        if(nodes[i].parent >= 0)
+        {
+            children[nodes[i].parent].push_back(i);
+        }
+
+        if(nodes[i].s.c == c.c && nodes[i].s.i.IsIntersects(c.timestep))
+        {
+            removed[i] = true;
+            stack.push_back(i);
+        }
+    }
+
+    while(!stack.empty())
+    {
+        const int i = stack.back();
+        stack.pop_back();
+
+        for(const int j: children[i])
+        {
+            if(!removed[j])
+            {
+                removed[j] = true;
+                stack.push_back(j);
+            }
+        }
+    }
+
+    if(n == 0 || removed[0]) // start vertex is invalidated
+    {
+        return {false, nullptr};
+    }
+
+    // rebuild surviving vertices. Safe intervals of any vertex other than the invalidated one are unchanged, yet their ordinal may have shifted
+    std::vector<Vertex*> restored(n, nullptr);
+    table.Reset(g.GetNumberOfIndices());
+
+    for(int i = 0; i < n; i++)
+    {
+        if(!removed[i])
+        {
+            const auto& node = nodes[i];
+            const auto& intervals = si.IntervalsOf(node.s.c);
+            const auto interval = intervals.find(node.s.i);
+            assert(interval != intervals.end() && *interval == node.s.i);
+
+            auto v = table.Create(g.IndexOf(node.s.c), std::distance(intervals.begin(), interval));
+            v->s = node.s;
+            v->g = node.g;
+            v->h = node.h;
+            v->nconflicts = node.nconflicts;
+            restored[i] = v;
+
+            if(node.in_open) // the frontier stays open, even if the goal survives, for the trees resumed from this one later
+            {
+                v->handler = open.push(v);
+                v->in_open = true;
+            }
+        }
+    }
+
+    for(int i = 0; i < n; i++)
+    {
+        if(restored[i] && nodes[i].parent >= 0)
+        {
+            restored[i]->parent = restored[nodes[i].parent];
+        }
+    }
+
+    // the tree was scored against the conflict-avoidance table of an older CT node, hence the collisions are recounted from the start vertex down
+    if(cat)
+    {
+        stack.push_back(0);
+        restored[0]->nconflicts = 0;
+
+        while(!stack.empty())
+        {
+            const int i = stack.back();
+            stack.pop_back();
+
+            for(const int j: children[i])
+            {
+                if(!restored[j])
+                    continue;
+                restored[j]->nconflicts = restored[i]->nconflicts + CollisionsOf(restored[i], restored[j], restored[j]->g, g, a);
+                stack.push_back(j);
+            }
+        }
+    }
+
+    auto reopen = [&open](Vertex* v)
+    {
+        if(v && !v->in_open)
+        {
+            v->handler = open.push(v);
+            v->in_open = true;
+        }
+    };
+
+    // invalidated vertices (and the new safe intervals of c) can be reached again only through their predecessors
+    for(int i = 0; i < n; i++)
+    {
+        if(removed[i])
+        {
+            for(const auto& predecessor: g.PredecessorsOf(nodes[i].s.c))
+            {
+                for(auto v: table.VerticesOf(g.IndexOf(predecessor)))
+                {
+                    reopen(v);
+                }
+            }
+        }
+    }
+
+    // a surviving goal vertex which was already expanded still has an optimal cost, since constraints only remove paths
+    if(tree.goal >= 0 && restored[tree.goal])
+    {
+        return {true, restored[tree.goal]};
+    }
+
+    return {true, nullptr};
+}
+
+void IncrementalSIPP::Keep(const size_t tree_key, const Vertex* goal)
+{
+    const auto n = table.Size();
+    SearchTree tree;
+    boost::unordered_map<const Vertex*, int> ids;
+    tree.nodes.reserve(n);
+
+    for(size_t i = 0; i < n; i++)
+    {
+        const auto v = table.At(i);
+        ids[v] = i;
+        tree.nodes.push_back({v->s, v->g, v->h, v->nconflicts, -1, v->in_open});
+    }
+
+    for(size_t i = 0; i < n; i++)
+    {
+        const auto parent = table.At(i)->parent;
+        if(parent)
+        {
+            tree.nodes[i].parent = ids.at(parent);
+        }
+    }
+
+    tree.goal = goal ? ids.at(goal) : -1;
+
+    if(!trees.contains(tree_key))
+    {
+        if(keys.size() >= capacity)
+        {
+            trees.erase(keys.front());
+            keys.pop_front();
+        }
+        keys.push_back(tree_key);
+    }
+
+    trees[tree_key] = std::move(tree);
+}
+
+size_t IncrementalSIPP::KeyOf(const Agent& a, const size_t key)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, a.index);
+    boost::hash_combine(seed, key);
+    return seed;
+}
+
+std::string IncrementalSIPP::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#Fresh low-level searches: " << nfresh << '\n' << "#Fresh low-level expansions: " << fresh_nexpansions << '\n';
+    ss << "#Resumed low-level searches: " << nresumed << '\n' << "#Resumed low-level expansions: " << resumed_nexpansions << '\n';
+    return ss.str();
+}
\ No newline at end of file
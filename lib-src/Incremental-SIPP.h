@@ -0,0 +1,52 @@
+#pragma once
+
+#include "SIPP.h"
+#include "Constraint.h"
+#include <boost/unordered_map.hpp>
+#include <deque>
+#include <vector>
+
+// SIPP which keeps the search tree of its recent searches. Given a single additional constraint, the tree of the previous search is repaired
+// rather than discarded, in the spirit of lifelong planning A*: vertices whose safe interval is split by the constraint are invalidated together
+// with their descendants, the closed predecessors of invalidated vertices are reopened and the search resumes from the surviving frontier.
+class IncrementalSIPP: public SIPP
+{
+public:
+    IncrementalSIPP(size_t capacity=256);
+    virtual ~IncrementalSIPP() = default;
+
+    using SIPP::Search;
+    std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si, size_t key) override;
+    std::tuple<Path, unsigned long> Resume(const Graph& g, const Agent& a, SafeIntervals& si, size_t key, size_t parent_key, const Constraint& c) override;
+    inline void Invalidate(void) override {trees.clear(); keys.clear();}
+    inline std::string GetName(void) const override {return "Incremental-SIPP";}
+    inline ILowLevelPlanner* Clone(void) const override {return new IncrementalSIPP(capacity);}
+    std::string GetStats(void) const override;
+
+protected:
+    struct Node
+    {
+        State s{};
+        float g = INF;
+        float h = 0;
+        int nconflicts = 0;
+        int parent = -1;
+        bool in_open = false;
+    };
+
+    struct SearchTree
+    {
+        std::vector<Node> nodes; // nodes[0] is the start vertex
+        int goal = -1;
+    };
+
+    size_t capacity;
+    boost::unordered_map<size_t, SearchTree> trees;
+    std::deque<size_t> keys; // trees keys ordered by insertion, the oldest tree is evicted first
+    unsigned long nfresh = 0, nresumed = 0;
+    unsigned long fresh_nexpansions = 0, resumed_nexpansions = 0;
+
+    static size_t KeyOf(const Agent& a, size_t key);
+    void Keep(size_t tree_key, const Vertex* goal);
+    std::tuple<bool, Vertex*> Restore(const SearchTree& tree, MinFibHeap& open, const Graph& g, const Agent& a, SafeIntervals& si, const Constraint& c);
+};
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Graph.h"
 #include "Types.h"
 #include <boost/unordered/unordered_map.hpp>
+#include <vector>
 
 class InformedHeuristic
 {
@@ -14,19 +15,12 @@ public:
     std::string ToString(void) const;
 
     float operator() (const Coordinate& c, const Coordinate& goal) const noexcept;
+    const std::vector<float>* DistancesTo(const Coordinate& goal) const noexcept; // dense distance-to-go table of goal, indexed as Graph::IndexOf. nullptr if goal is not a source
+    inline int IndexOf(const Coordinate& c) const noexcept {return c.row * ncolumns + c.column;}
     inline operator bool () const {return !dist.empty();};
     inline friend std::ostream& operator << (std::ostream& out, const InformedHeuristic& ih) {return out << ih.ToString();}
 
 private:
-    struct CoordinatePair
-    {
-        const Coordinate c1, c2;
-
-        inline bool operator != (const CoordinatePair& other) {return c1 != other.c1 || c2 != other.c2;}
-        struct CoordinatePairEqual{bool operator () (const CoordinatePair& cp1, const CoordinatePair& cp2) const noexcept;};
-        struct CoordinatePairHasher{size_t operator () (const CoordinatePair& cp) const noexcept;};
-    };
-
     struct Node
     {
         Coordinate c;
@@ -38,6 +32,7 @@ private:
 
     void Dijkstra(const Graph& g, const Coordinate& goal);
     
-    // run Dijkstra from each agent goal. dist[{goal, v}] = minimum distance-to-go from v to goal (assuming undirected graph)
-    boost::unordered::unordered_map<CoordinatePair, float, CoordinatePair::CoordinatePairHasher, CoordinatePair::CoordinatePairEqual> dist;
+    // run Dijkstra from each agent goal. dist[goal][IndexOf(v)] = minimum distance-to-go from v to goal (assuming undirected graph)
+    boost::unordered::unordered_map<Coordinate, std::vector<float>, Coordinate::Hasher, Coordinate::Equal> dist;
+    int nindices = 0, ncolumns = 0;
 };
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include "Coordinate.h"
 #include "Graph.h"
 #include "InformedHeuristic.h"
-#include <boost/heap/fibonacci_heap.hpp>
 #include <boost/unordered/unordered_map.hpp>
+#include <queue>
+#include <sstream>
 
-InformedHeuristic::InformedHeuristic(const Graph& g, const Agents& as, const EdgeSet& maybe_blocked_edges)
+InformedHeuristic::InformedHeuristic(const Graph& g, const Agents& as, const EdgeSet& maybe_blocked_edges): nindices(g.GetNumberOfIndices()), ncolumns(g.GetNumberOfColumns())
 {
     for(const auto& a: as)
     {
@@ -19,26 +20,40 @@ InformedHeuristic::InformedHeuristic(const Graph& g, const Agents& as, const Edg
 
 void InformedHeuristic::Dijkstra(const Graph& g, const Coordinate& goal)
 {
-    boost::heap::fibonacci_heap<Node, boost::heap::compare<Node::NodeComparator>> q;
-    boost::unordered::unordered_map<Coordinate, float, Coordinate::Hasher, Coordinate::Equal> g_cost;
+    if(dist.contains(goal))
+    {
+        return;
+    }
+
+    if(!g.GetVertices().contains(goal)) // e.g, the goal of a placeholder agent, only the distance from itself is known
+    {
+        dist.emplace(goal, std::vector<float>());
+        return;
+    }
+
+    std::priority_queue<Node, std::vector<Node>, Node::NodeComparator> q;
+    auto& g_cost = dist.emplace(goal, std::vector<float>(nindices, INF)).first->second;
 
     q.push({goal, 0});
-    g_cost[goal] = 0;
-    dist[{goal, goal}] = 0;
+    g_cost[IndexOf(goal)] = 0;
 
     while(!q.empty())
     {
         const auto [p, p_cost] = q.top();
         q.pop();
 
-        for(const auto& s: g.SuccessorsOf(p))
+        if(p_cost > g_cost[IndexOf(p)]) // stale entry, p was already reached cheaper
+        {
+            continue;
+        }
+
+        for(const auto& s: g.AdjacentOf(p))
         {
-            if(g_cost.find(s) == g_cost.end() || g_cost.at(s) > p_cost + g.WeightOf({p, s}))
+            const auto s_cost = p_cost + g.WeightOf({p, s});
+            if(g_cost[IndexOf(s)] > s_cost)
             {
-                auto s_cost = p_cost + g.WeightOf({p, s});;
-                g_cost[s] = s_cost;
+                g_cost[IndexOf(s)] = s_cost;
                 q.push({s, s_cost});
-                dist[{goal, s}] = s_cost;
             }
         }
     }
@@ -46,35 +61,44 @@ void InformedHeuristic::Dijkstra(const Graph& g, const Coordinate& goal)
 
 float InformedHeuristic::operator() (const Coordinate& c, const Coordinate& goal) const noexcept
 {
-    return dist.contains({goal, c}) ? dist.at({goal, c}) : INF;
-}
+    const auto iter = dist.find(goal);
+    const int i = IndexOf(c);
 
-std::string InformedHeuristic::ToString(void) const
-{
-    std::stringstream ss;
-    int i = 1;
+    if(iter == dist.end())
+    {
+        return INF;
+    }
 
-    for(const auto& [cp, d]: dist)
+    if(c == goal)
     {
-        ss << i << ")\t" << "dist(" << cp.c1 << ", " << cp.c2 << ") = " << d << '\n';
-        i += 1;
+        return 0;
     }
 
-    return ss.str();
+    return c.column >= 0 && c.column < ncolumns && i >= 0 && i < (int)iter->second.size() ? iter->second[i] : INF;
 }
 
-bool InformedHeuristic::CoordinatePair::CoordinatePairEqual::operator() (const CoordinatePair& cp1, const CoordinatePair& cp2) const noexcept
+const std::vector<float>* InformedHeuristic::DistancesTo(const Coordinate& goal) const noexcept
 {
-    return cp1.c1 == cp2.c1 && cp1.c2 == cp2.c2;
+    const auto iter = dist.find(goal);
+    return iter != dist.end() ? &iter->second : nullptr;
 }
 
-size_t InformedHeuristic::CoordinatePair::CoordinatePairHasher::operator() (const CoordinatePair& cp) const noexcept
+std::string InformedHeuristic::ToString(void) const
 {
-    Coordinate::Hasher coordinate_hasher;
-    std::size_t seed = 0;
+    std::stringstream ss;
+    int i = 1;
 
-    boost::hash_combine(seed, (coordinate_hasher(cp.c1)));
-    boost::hash_combine(seed, (coordinate_hasher(cp.c2)));
+    for(const auto& [goal, table]: dist)
+    {
+        for(int j = 0; j < nindices; j++)
+        {
+            if(table[j] < INF)
+            {
+                ss << i << ")\t" << "dist(" << goal << ", " << Coordinate(j / ncolumns, j % ncolumns) << ") = " << table[j] << '\n';
+                i += 1;
+            }
+        }
+    }
 
-    return seed;
+    return ss.str();
 }
\ No newline at end of file
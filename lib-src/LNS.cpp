@@ -0,0 +1,269 @@
+#include "LNS.h"
+#include "InformedHeuristic.h"
+#include "Timer.h"
+#include "Utils.h"
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <sstream>
+
+LNS::LNS(ILowLevelPlanner* llp, const int neighborhood_size, const int niterations): PP(llp), neighborhood_size(std::max(1, neighborhood_size)), niterations(niterations){}
+
+void LNS::Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k)
+{
+    PP::Init(policy, ih, k);
+    stats = {};
+    tabu.clear();
+    niterations_total = 0;
+}
+
+std::tuple<bool, unsigned long> LNS::Replan(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, const float timeout, const int current_timestep)
+{
+    Timer timer;
+    timer.Start(timeout);
+
+    const bool is_plan_found = std::get<0>(PP::Replan(g, all, planned_paths, affected, timeout, current_timestep));
+
+    if(is_plan_found)
+    {
+        // leave at least half the remaining runtime to the execution of the plan, the improvement may stop at any iteration
+        Improve(g, all, planned_paths, affected, timer.GetRemainingRuntime() / 2);
+    }
+
+    return {is_plan_found && !timer.ExceedsRuntime(), nexpansions};
+}
+
+void LNS::Improve(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& around, const float timeout)
+{
+    Timer timer;
+    std::vector<int> seeds;
+    std::vector<std::pair<int, Path>> destroyed;
+
+    timer.Start(timeout);
+    is_index_stale = true;
+
+    for(const auto i: around)
+    {
+        if(!planned_paths[i].empty())
+        {
+            seeds.push_back(i);
+        }
+    }
+    std::sort(seeds.begin(), seeds.end());
+
+    for(int iteration = 0; iteration < niterations && !seeds.empty() && !timer.ExceedsRuntime() && !IsCancelled(); iteration++)
+    {
+        const auto h = Select();
+        auto& s = stats[(int)h];
+        const auto neighborhood = Destroy(h, g, all, planned_paths, seeds);
+        long old_cost = 0, new_cost = 0;
+
+        destroyed.clear();
+        for(const auto i: neighborhood)
+        {
+            old_cost += ObjectiveFunction::PathLength(planned_paths[i]);
+            destroyed.emplace_back(i, planned_paths[i]);
+        }
+
+        const bool is_repaired = !neighborhood.empty() && ReplanGroup(g, all, planned_paths, neighborhood).empty();
+
+        for(const auto i: neighborhood)
+        {
+            new_cost += ObjectiveFunction::PathLength(planned_paths[i]);
+        }
+
+        if(is_repaired && new_cost < old_cost)
+        {
+            s.nimproved += 1;
+            s.gain += old_cost - new_cost;
+            is_index_stale = true;
+        }
+        else
+        {
+            // either some agent could not be repaired or the repair is not better, restore the destroyed paths
+            for(auto& [i, p]: destroyed)
+            {
+                planned_paths[i] = std::move(p);
+            }
+        }
+
+        const float improvement = is_repaired && new_cost < old_cost ? (float)(old_cost - new_cost) / neighborhood.size() : 0;
+        s.weight = std::max(1e-3f, reaction * improvement + (1 - reaction) * s.weight);
+        s.ndestroyed += 1;
+        niterations_total += 1;
+    }
+}
+
+LNS::Heuristic LNS::Select(void)
+{
+    std::discrete_distribution<int> roulette({stats[0].weight, stats[1].weight, stats[2].weight});
+    return (Heuristic)roulette(gen);
+}
+
+AgentsIndicesSet LNS::Destroy(const Heuristic h, const Graph& g, const Agents& all, const Paths& planned_paths, const std::vector<int>& seeds)
+{
+    if(h != Heuristic::Random && is_index_stale)
+    {
+        IndexVisitors(planned_paths);
+    }
+
+    switch(h)
+    {
+        case Heuristic::AgentBased:
+            return AgentBasedNeighborhood(all, planned_paths, seeds);
+        case Heuristic::MapBased:
+            return MapBasedNeighborhood(g, planned_paths, seeds);
+        default:
+            return RandomNeighborhood(seeds);
+    }
+}
+
+AgentsIndicesSet LNS::RandomNeighborhood(const std::vector<int>& seeds)
+{
+    AgentsIndicesSet neighborhood;
+    std::sample(seeds.begin(), seeds.end(), std::inserter(neighborhood, neighborhood.begin()), neighborhood_size, gen);
+    return neighborhood;
+}
+
+AgentsIndicesSet LNS::AgentBasedNeighborhood(const Agents& all, const Paths& planned_paths, const std::vector<int>& seeds)
+{
+    AgentsIndicesSet neighborhood;
+    std::deque<int> q;
+    int seed = -1;
+    float max_delay = 0;
+
+    // the most delayed seed, among those which were not picked since the tabu list was last reset
+    for(int attempt = 0; attempt < 2 && seed == -1; attempt++)
+    {
+        for(const auto i: seeds)
+        {
+            const float delay = ObjectiveFunction::PathLength(planned_paths[i]) - (*ih)(all[i].start, all[i].goal);
+            if(delay > max_delay && !tabu.contains(i))
+            {
+                seed = i;
+                max_delay = delay;
+            }
+        }
+
+        if(seed == -1)
+        {
+            tabu.clear();
+        }
+    }
+
+    if(seed == -1) // no seed is delayed, hence the agents around them are planned optimally as well
+    {
+        return neighborhood;
+    }
+
+    // grow the neighborhood by the agents which visit the cells the agents of the neighborhood pass through
+    tabu.insert(seed);
+    neighborhood.insert(seed);
+    q.push_back(seed);
+
+    while(!q.empty() && (int)neighborhood.size() < neighborhood_size)
+    {
+        const int i = q.front();
+        q.pop_front();
+
+        for(const auto& c: planned_paths[i])
+        {
+            for(const auto j: visitors[c])
+            {
+                if((int)neighborhood.size() < neighborhood_size && neighborhood.insert(j).second)
+                {
+                    q.push_back(j);
+                }
+            }
+        }
+    }
+
+    return neighborhood;
+}
+
+AgentsIndicesSet LNS::MapBasedNeighborhood(const Graph& g, const Paths& planned_paths, const std::vector<int>& seeds)
+{
+    AgentsIndicesSet neighborhood;
+    CoordinateSet visited;
+    std::deque<Coordinate> q;
+    const auto& p = planned_paths[seeds[std::uniform_int_distribution<size_t>(0, seeds.size() - 1)(gen)]];
+    const auto& center = p[std::uniform_int_distribution<size_t>(0, p.size() - 1)(gen)];
+
+    // breadth-first around a random cell on the path of a random seed, collecting the agents which visit the reached cells
+    visited.insert(center);
+    q.push_back(center);
+
+    while(!q.empty() && (int)neighborhood.size() < neighborhood_size)
+    {
+        const auto u = q.front();
+        q.pop_front();
+
+        const auto iter = visitors.find(u);
+        if(iter != visitors.end())
+        {
+            for(const auto j: iter->second)
+            {
+                if((int)neighborhood.size() < neighborhood_size)
+                {
+                    neighborhood.insert(j);
+                }
+            }
+        }
+
+        for(const auto& v: g.AdjacentOf(u))
+        {
+            if(visited.insert(v).second)
+            {
+                q.push_back(v);
+            }
+        }
+    }
+
+    return neighborhood;
+}
+
+void LNS::IndexVisitors(const Paths& planned_paths)
+{
+    visitors.clear();
+
+    for(int i = 0; i < (int)planned_paths.size(); i++)
+    {
+        for(const auto& c: planned_paths[i])
+        {
+            auto& v = visitors[c];
+            if(v.empty() || v.back() != i) // waits visit the same cell consecutively
+            {
+                v.push_back(i);
+            }
+        }
+    }
+
+    is_index_stale = false;
+}
+
+std::string LNS::NameOf(const Heuristic h)
+{
+    switch(h)
+    {
+        case Heuristic::AgentBased:
+            return "Agent-based";
+        case Heuristic::MapBased:
+            return "Map-based";
+        default:
+            return "Random";
+    }
+}
+
+std::string LNS::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#LNS iterations: " << niterations_total << '\n';
+
+    for(int h = 0; h < nheuristics; h++)
+    {
+        const auto& s = stats[h];
+        ss << "#" << NameOf((Heuristic)h) << " neighborhoods: " << s.ndestroyed << ", #improving: " << s.nimproved << ", SOC gain: " << s.gain << ", weight: " << s.weight << '\n';
+    }
+
+    return ss.str() + PP::GetStats();
+}
\ No newline at end of file
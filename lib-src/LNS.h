@@ -0,0 +1,52 @@
+#pragma once
+
+#include "PP.h"
+#include <array>
+#include <vector>
+
+// Large neighborhood search (MAPF-LNS). A feasible plan is found by PP, then improved by repeatedly destroying the paths of a neighborhood of
+// agents and repairing them by PP against the paths of all the other agents. A repair is kept only if it lowers the sum of costs.
+// The destroy heuristic is drawn by an adaptive roulette wheel, which favors the heuristics that recently improved the plan.
+// Upon replanning, neighborhoods are grown only around the affected agents.
+class LNS: public PP
+{
+public:
+    enum class Heuristic {Random, AgentBased, MapBased, Count};
+
+    LNS(ILowLevelPlanner* llp, int neighborhood_size=8, int niterations=100);
+    virtual ~LNS() = default;
+
+    std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) override;
+
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    inline std::string GetName(void) const override {return "LNS(" + std::to_string(neighborhood_size) + ")+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    std::string GetStats(void) const override;
+
+protected:
+    static constexpr int nheuristics = (int)Heuristic::Count;
+    static constexpr float reaction = 0.01; // how fast the roulette weights follow the recent improvements
+
+    struct HeuristicStats
+    {
+        float weight = 1;
+        unsigned long ndestroyed = 0, nimproved = 0;
+        long gain = 0; // sum of costs saved by the heuristic so far
+    };
+
+    int neighborhood_size;
+    int niterations; // per call of Replan
+    std::array<HeuristicStats, nheuristics> stats;
+    AgentsIndicesSet tabu; // seeds of agent-based neighborhoods since they were last reset
+    CoordinateMap visitors; // cell -> agents whose path visits it
+    bool is_index_stale = true; // visitors do not reflect the current paths
+    unsigned long niterations_total = 0;
+
+    void Improve(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& around, float timeout);
+    Heuristic Select(void);
+    AgentsIndicesSet Destroy(Heuristic h, const Graph& g, const Agents& all, const Paths& planned_paths, const std::vector<int>& seeds);
+    AgentsIndicesSet RandomNeighborhood(const std::vector<int>& seeds);
+    AgentsIndicesSet AgentBasedNeighborhood(const Agents& all, const Paths& planned_paths, const std::vector<int>& seeds);
+    AgentsIndicesSet MapBasedNeighborhood(const Graph& g, const Paths& planned_paths, const std::vector<int>& seeds);
+    void IndexVisitors(const Paths& planned_paths);
+    static std::string NameOf(Heuristic h);
+};
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Astar.h"
 #include "DisjointSets.h"
+#include "GroupAgents.h"
 #include "Graph.h"
 #include "IHighLevelPlanner.h"
 #include "IPlanner.h"
@@ -24,7 +25,8 @@ ScenarioResult LocalPlanner::Plan(const Snapshot& snap, const Agents& src, const
     EdgeSet observed_maybe_open_edge, observed_maybe_blocked_edge;
     EdgeSet new_observed_maybe_open_edge, new_observed_maybe_blocked_edge;
     Agents as(src);
-    Paths realized(K);
+    TrajectoryBuffer realized(K);
+    PlanBuffer ongoing;
     Paths plans(K);
     int timestep = 0;
     int replans = 0;
@@ -44,6 +46,8 @@ ScenarioResult LocalPlanner::Plan(const Snapshot& snap, const Agents& src, const
         LogPlan(plans);
     #endif
 
+    ongoing.Swap(std::move(plans));
+
     while(is_planning_succeed && !timer.ExceedsRuntime() && !Validator::AreAllAgentsReachedTheirGoals(as, realized))
     {
         std::tie(new_observed_maybe_open_edge, new_observed_maybe_blocked_edge) = Observe(as, g, snap, observed_maybe_open_edge, observed_maybe_blocked_edge);
@@ -58,30 +62,34 @@ ScenarioResult LocalPlanner::Plan(const Snapshot& snap, const Agents& src, const
             UpdateGraph(g, new_observed_maybe_open_edge, new_observed_maybe_blocked_edge);
             policy->Update(new_observed_maybe_open_edge, new_observed_maybe_blocked_edge);
 
+            plans = ongoing.Remaining();
             is_planning_succeed = Replan(g, as, plans, FindAffectedAgents(g, plans, new_observed_maybe_open_edge, new_observed_maybe_blocked_edge, ih));
             replans += 1;
 
             #ifdef LOG
                 LogPlan(plans);
             #endif
+
+            ongoing.Swap(std::move(plans));
         }
 
         // resolve collision
-        auto conflicting_groups = DetectCollisions(plans, as);
+        auto conflicting_groups = DetectCollisions(ongoing.RemainingViews(), as);
         while(!conflicting_groups.empty() && is_planning_succeed && !timer.ExceedsRuntime())
         {
             for(const auto& group: conflicting_groups)
             {
-                Paths conflicting_agents_revised_plans(K);
-                std::tie(is_planning_succeed, conflicting_agents_revised_plans, high_level_nexpansions, runtime) = ihlp->Plan(g, ExtractAgentsSubset(group, as), timer.GetRemainingRuntime());
+                const GroupAgents group_agents(group, as);
+                Paths conflicting_agents_revised_plans;
+                std::tie(is_planning_succeed, conflicting_agents_revised_plans, high_level_nexpansions, runtime) = ihlp->Plan(g, group_agents.Local(), timer.GetRemainingRuntime());
                 total_nexpansions += high_level_nexpansions;
                 replans += 1;
 
                 if(is_planning_succeed)
                 {
-                    for(const auto i: group)
+                    for(int i = 0; i < group_agents.Size(); i++)
                     {
-                        plans[i] = std::forward<Path>(conflicting_agents_revised_plans[i]);
+                        ongoing.Swap(group_agents.GlobalOf(i), std::forward<Path>(conflicting_agents_revised_plans[i]));
                     }
 
                     conflicting_agents_revised_plans.clear();
@@ -94,7 +102,7 @@ ScenarioResult LocalPlanner::Plan(const Snapshot& snap, const Agents& src, const
 
             if(is_planning_succeed)
             {
-                auto next_conflicting_groups = DetectCollisions(plans, as);
+                auto next_conflicting_groups = DetectCollisions(ongoing.RemainingViews(), as);
                 if(!next_conflicting_groups.empty())
                 {
                     conflicting_groups = Merge({conflicting_groups, next_conflicting_groups}, K);
@@ -109,7 +117,7 @@ ScenarioResult LocalPlanner::Plan(const Snapshot& snap, const Agents& src, const
 
         if(is_planning_succeed)
         {
-            Step(as, realized, plans);
+            Step(as, realized, ongoing);
             
             #ifdef LOG
                 LogStep(realized, timestep);
@@ -121,10 +129,10 @@ ScenarioResult LocalPlanner::Plan(const Snapshot& snap, const Agents& src, const
 
     is_planning_succeed = is_planning_succeed && !timer.ExceedsRuntime();
 
-    return {is_planning_succeed, is_planning_succeed ? Prune(realized): Paths(), timer.Stop(), replans, total_nexpansions};
+    return {is_planning_succeed, is_planning_succeed ? Prune(realized.ToPaths()): Paths(), timer.Stop(), replans, total_nexpansions};
 }
 
-std::vector<AgentsIndicesSet> LocalPlanner::DetectCollisions(const Paths& plans, const Agents& all)
+std::vector<AgentsIndicesSet> LocalPlanner::DetectCollisions(const PathViews& plans, const Agents& all)
 {
     const auto K = all.size();
     std::vector<AgentsIndicesSet> groups;
@@ -144,18 +152,6 @@ std::vector<AgentsIndicesSet> LocalPlanner::DetectCollisions(const Paths& plans,
     return BuildGroups(ds);
 }
 
-Agents LocalPlanner::ExtractAgentsSubset(const AgentsIndicesSet& agents_subset_indices, const Agents& all)
-{
-    Agents subset(all.size());
-
-    for(auto i: agents_subset_indices)
-    {
-        subset[i] = all[i];
-    }
-
-    return subset;
-}
-
 std::vector<AgentsIndicesSet> LocalPlanner::Merge(const std::vector<std::vector<AgentsIndicesSet>>& groups_set, const size_t K)
 {
     DisjointSets ds(K);
@@ -16,14 +16,14 @@ public:
 
     ScenarioResult Plan(const Snapshot& snap, const Agents& src, const InformedHeuristic& ih, float timeout) override;
     virtual inline std::string GetName(void) const override {return "Local+" + ihlp->GetName() + "+" + policy->GetName();}
+    inline std::string GetStats(void) const override {return ihlp->GetStats();}
 
 protected:
     IHighLevelPlanner* ihlp;
     Astar astar;
     int r;
 
-    std::vector<AgentsIndicesSet> DetectCollisions(const Paths& plans, const Agents& all);
-    Agents ExtractAgentsSubset(const AgentsIndicesSet& agents_subset_indices, const Agents& all);
+    std::vector<AgentsIndicesSet> DetectCollisions(const PathViews& plans, const Agents& all);
     std::vector<AgentsIndicesSet> Merge(const std::vector<std::vector<AgentsIndicesSet>>& groups_set, size_t K);
     std::vector<AgentsIndicesSet> BuildGroups(DisjointSets& ds);
     virtual bool Replan(const Graph& g, const Agents& as, Paths& ongoing_plans, const AgentsIndicesSet& affected);
@@ -0,0 +1,272 @@
+#include "MA-CBS.h"
+#include "GroupAgents.h"
+#include "IConflict.h"
+#include "Timer.h"
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+
+MACBS::MACBS(ILowLevelPlanner* llp, const int merge_threshold, const bool is_restarting): CBS(llp), merge_threshold(merge_threshold), is_restarting(is_restarting), metas(0){}
+
+void MACBS::Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k)
+{
+    CBS::Init(policy, ih, k);
+
+    if(merge_threshold >= 0)
+    {
+        inner = std::make_unique<MACBS>(llp->Clone(), -1);
+        inner->Init(policy, ih, k);
+    }
+}
+
+std::string MACBS::GetName(void) const
+{
+    return "MA-CBS(" + std::to_string(merge_threshold) + (is_restarting ? ",restart" : "") + ")+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");
+}
+
+CBS* MACBS::Fork(void) const
+{
+    return new MACBS(llp->Clone(), merge_threshold, is_restarting);
+}
+
+std::tuple<bool, Paths, Constraints> MACBS::Search(const Graph& g, const Agents& as, const float timeout)
+{
+    CTNode goal;
+    MinFibHeap open;
+    Timer timer;
+    bool is_plan_found = false;
+    llp->Invalidate();
+    mdds.clear();
+    pair_weights.clear();
+    pair_conflicts.clear();
+    metas = DisjointSets(as.size());
+    members.clear();
+
+    timer.Start(timeout);
+
+    auto root = Root(g, as, timer.GetRemainingRuntime());
+    if(root)
+    {
+        open.push(root);
+    }
+
+    while(!open.empty() && !timer.ExceedsRuntime() && !IsCancelled() && !is_plan_found)
+    {
+        auto n = open.top();
+        open.pop();
+
+        is_plan_found = n.conflicts.IsEmpty();
+        if(is_plan_found)
+        {
+            goal = std::forward<CTNode>(n);
+            continue;
+        }
+
+        auto [c, cardinality] = ChooseConflict(n, g, as);
+        const int i = c->agents_indices[0], j = c->agents_indices[1];
+
+        if(ShouldMerge(i, j))
+        {
+            if(is_restarting)
+            {
+                // the merged meta-agent is planned jointly from the root on
+                open.clear();
+                lookup.clear();
+                nrestarts += 1;
+                root = Root(g, as, timer.GetRemainingRuntime());
+                if(root)
+                {
+                    open.push(root);
+                }
+            }
+            else
+            {
+                high_level_nexpansions += 1;
+                auto merged = ReplanMetaAgent(n, MembersOf(i), nullptr, g, as, timer.GetRemainingRuntime());
+                if(merged)
+                {
+                    lookup.insert(merged.hash);
+                    open.push(merged);
+                }
+            }
+        }
+        else
+        {
+            nsplit[(int)cardinality] += 1;
+
+            // same as CBS::Expand, yet a constraint on a member of a meta-agent replans the whole meta-agent
+            for(const auto& new_constraint: c->Resolve())
+            {
+                const auto successor_hash = n.hash ^ Constraint::Hasher{}(new_constraint);
+
+                if(!lookup.contains(successor_hash))
+                {
+                    high_level_nexpansions += 1;
+                    const auto meta_agent = MembersOf(new_constraint.constrained_agent);
+                    auto successor = meta_agent.size() > 1 ?
+                        ReplanMetaAgent(n, meta_agent, &new_constraint, g, as, timer.GetRemainingRuntime()) :
+                        Generate(g, as[new_constraint.constrained_agent], n, new_constraint, llp);
+
+                    if(successor)
+                    {
+                        lookup.insert(successor.hash);
+                        successor.h = HeuristicOf(successor, g, as, llp);
+                        open.push(successor);
+                    }
+                }
+            }
+        }
+
+        delete c;
+    }
+
+    lookup.clear();
+
+    return {is_plan_found && !timer.ExceedsRuntime(), Materialize(goal.paths), Collect(goal.constraints)};
+}
+
+CBS::CTNode MACBS::Root(const Graph& g, const Agents& as, const float timeout)
+{
+    auto root = CBS::Init(g, as, root_constraints);
+
+    for(const auto& [representative, meta_agent]: members)
+    {
+        if(!root)
+            break;
+
+        root = ReplanMetaAgent(root, meta_agent, nullptr, g, as, timeout);
+    }
+
+    return root;
+}
+
+bool MACBS::ShouldMerge(const int i, const int j)
+{
+    if(merge_threshold < 0)
+        return false;
+
+    // conflicts between members of the same meta-agent are left by nodes generated before the merge
+    if(metas.FindSet(i) == metas.FindSet(j))
+        return true;
+
+    pair_conflicts[std::minmax(i, j)] += 1;
+
+    int nconflicts = 0;
+    const auto meta_agent1 = MembersOf(i), meta_agent2 = MembersOf(j);
+    for(const int x: meta_agent1)
+    {
+        for(const int y: meta_agent2)
+        {
+            const auto iter = pair_conflicts.find(std::minmax(x, y));
+            nconflicts += (iter != pair_conflicts.end()) ? iter->second : 0;
+        }
+    }
+
+    if(nconflicts <= merge_threshold)
+        return false;
+
+    auto merged = meta_agent1;
+    merged.insert(merged.end(), meta_agent2.begin(), meta_agent2.end());
+    members.erase(metas.FindSet(i));
+    members.erase(metas.FindSet(j));
+    metas.Union(i, j);
+    members[metas.FindSet(i)] = std::move(merged);
+    nmerges += 1;
+
+    return true;
+}
+
+std::vector<int> MACBS::MembersOf(const int agent_index)
+{
+    const auto iter = members.find(metas.FindSet(agent_index));
+    return iter != members.end() ? iter->second : std::vector<int>{agent_index};
+}
+
+CBS::CTNode MACBS::ReplanMetaAgent(const CTNode& parent, const std::vector<int>& meta_agent, const Constraint* new_constraint, const Graph& g, const Agents& as, const float timeout)
+{
+    CTNode n;
+    const AgentsIndicesSet group(meta_agent.begin(), meta_agent.end());
+    const GroupAgents group_agents(group, as);
+    auto constraints = parent.constraints;
+    inner->root_constraints.clear();
+
+    // constraints between members are dropped, the rest are imposed on the inner search in terms of its local agents
+    for(int i = 0; i < group_agents.Size(); i++)
+    {
+        const int agent_index = group_agents.GlobalOf(i);
+        std::vector<Constraint> cs;
+        for(auto link = ChainOf(parent.constraints, agent_index).get(); link; link = link->parent.get())
+        {
+            if(!group.contains(link->c.conflicted_agent))
+                cs.push_back(link->c);
+        }
+        std::reverse(cs.begin(), cs.end());
+
+        if(new_constraint && new_constraint->constrained_agent == agent_index)
+            cs.push_back(*new_constraint);
+
+        ConstraintChain::Ptr chain, local_chain;
+        for(const auto& c: cs)
+        {
+            chain = ConstraintChain::Push(chain, c);
+            auto local = c;
+            local.constrained_agent = i;
+            local.conflicted_agent = -1;
+            local_chain = ConstraintChain::Push(local_chain, local);
+        }
+
+        if(chain)
+        {
+            constraints[agent_index] = std::move(chain);
+            inner->root_constraints[i] = std::move(local_chain);
+        }
+        else
+        {
+            constraints.erase(agent_index);
+        }
+    }
+
+    auto&& [is_plan_found, paths, inner_constraints] = inner->Search(g, group_agents.Local(), timeout);
+    inner_nexpansions += inner->high_level_nexpansions;
+    Absorb(*inner);
+    inner->root_constraints.clear();
+
+    if(is_plan_found)
+    {
+        n.paths = parent.paths;
+        n.lower_bounds = parent.lower_bounds;
+        n.cost = parent.cost;
+        n.lower_bound = parent.lower_bound;
+
+        // the inner search is optimal, the cost of each path is its own lower bound
+        for(int i = 0; i < group_agents.Size(); i++)
+        {
+            const int agent_index = group_agents.GlobalOf(i);
+            n.paths[agent_index] = std::make_shared<const SegmentedPath>(paths[i]);
+            n.cost = n.cost - PathLength(parent.paths[agent_index]) + PathLength(n.paths[agent_index]);
+            n.lower_bounds[agent_index] = PathLength(n.paths[agent_index]);
+            n.lower_bound = n.lower_bound - parent.lower_bounds[agent_index] + n.lower_bounds[agent_index];
+        }
+
+        n.constraints = std::move(constraints);
+        n.hash = std::accumulate(n.constraints.begin(), n.constraints.end(), size_t(0), [](const size_t hash, const auto& entry){return hash ^ entry.second->key;});
+        n.conflicts = parent.conflicts;
+        for(const int agent_index: meta_agent)
+        {
+            n.conflicts.Update(agent_index, n.paths);
+        }
+        n.nconflicts = n.conflicts.Count();
+        ngenerated += 1;
+    }
+
+    return n;
+}
+
+std::string MACBS::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#Meta-agent merges: " << nmerges << '\n';
+    ss << "#Restarts: " << nrestarts << '\n';
+    ss << "#Inner CT node expansions: " << inner_nexpansions << '\n';
+    return ss.str() + CBS::GetStats();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CBS.h"
+#include "DisjointSets.h"
+#include <boost/unordered_map.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Meta-agent CBS. Conflicts are counted per pair of agents over the whole constraint tree. Once the agents of two meta-agents conflicted more than
+// B times, the meta-agents are merged and the merged one is planned jointly by an inner CBS, rather than being split again and again.
+// Constraints between members of a meta-agent are dropped, the inner search resolves their conflicts. A constraint on a member replans its
+// whole meta-agent. Optionally, the search restarts from the root once agents are merged.
+class MACBS: public CBS
+{
+public:
+    MACBS(ILowLevelPlanner* llp, int merge_threshold=10, bool is_restarting=false); // agents are never merged if merge_threshold < 0
+    virtual ~MACBS() = default;
+
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    std::string GetName(void) const override;
+    std::string GetStats(void) const override;
+
+protected:
+    using PairConflicts = boost::unordered_map<std::pair<int, int>, int>; // <i, j> s.t i < j -> number of conflicts between i and j split so far
+
+    int merge_threshold; // B
+    bool is_restarting;
+    std::unique_ptr<MACBS> inner; // plans merged meta-agents, never merges on its own
+    ConstraintIndex root_constraints; // imposed on the root of the next search, used by the inner search
+    PairConflicts pair_conflicts;
+    DisjointSets metas; // partition of the agents into meta-agents
+    boost::unordered_map<int, std::vector<int>> members; // representative of a meta-agent of more than one agent -> its agents
+    unsigned long nmerges = 0, nrestarts = 0, inner_nexpansions = 0;
+
+    std::tuple<bool, Paths, Constraints> Search(const Graph& g, const Agents& as, float timeout) override;
+    CBS* Fork(void) const override;
+    CTNode Root(const Graph& g, const Agents& as, float timeout);
+    bool ShouldMerge(int i, int j);
+    std::vector<int> MembersOf(int agent_index);
+    CTNode ReplanMetaAgent(const CTNode& parent, const std::vector<int>& meta_agent, const Constraint* new_constraint, const Graph& g, const Agents& as, float timeout);
+};
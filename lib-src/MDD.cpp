@@ -0,0 +1,115 @@
+#include "MDD.h"
+#include "Graph.h"
+#include "InformedHeuristic.h"
+#include "SafeIntervals.h"
+#include <algorithm>
+
+MDD::MDD(const Graph& g, const Agent& a, const InformedHeuristic& ih, const ConstraintChain* constraints, const int cost): layers(cost + 1), goal(a.goal), cost(cost)
+{
+    struct Node
+    {
+        Coordinate c;
+        int first_child = 0, last_child = 0; // range of children, positions at the next layer are kept in children[first_child, last_child)
+        bool leads_to_goal = false;
+    };
+
+    // vertex constraints are looked up directly, the other kinds through the safe intervals they leave
+    Constraints cs;
+    SafeIntervals si;
+    bool is_bulk_constrained = false;
+    for(; constraints; constraints = constraints->parent.get())
+    {
+        if(constraints->c.kind == Constraint::Kind::Vertex)
+        {
+            cs.insert(constraints->c);
+        }
+        else
+        {
+            si.Add(constraints->c);
+            is_bulk_constrained = true;
+        }
+    }
+
+    // forward: coordinates reachable at timestep t, from which the goal is still reachable by the given cost
+    std::vector<std::vector<Node>> nodes(cost + 1);
+    std::vector<int> position(g.GetNumberOfIndices(), -1), stamp(g.GetNumberOfIndices(), -1); // position of a coordinate at the layer of its stamp
+    std::vector<float> h(g.GetNumberOfIndices(), -1); // distance-to-go, looked up once per coordinate
+    std::vector<int> children;
+
+    auto is_allowed = [&](const Coordinate& c, const int t)
+    {
+        auto& distance = h[g.IndexOf(c)];
+        if(distance < 0)
+            distance = ih(c, a.goal);
+
+        return distance <= cost - t && (cs.empty() || !cs.contains({a.index, c, t})) && (!is_bulk_constrained || si.FirstSafeInterval(c, t).IsIntersects(t));
+    };
+
+    if(cost >= si.GetMinimalLength() && is_allowed(a.start, 0))
+    {
+        nodes[0].push_back({a.start});
+    }
+
+    for(int t = 0; t < cost; t++)
+    {
+        auto& next = nodes[t + 1];
+
+        for(auto& n: nodes[t])
+        {
+            auto visit = [&](const Coordinate& s)
+            {
+                const int i = g.IndexOf(s);
+                if(stamp[i] != t + 1)
+                {
+                    if(!is_allowed(s, t + 1))
+                        return;
+
+                    stamp[i] = t + 1;
+                    position[i] = next.size();
+                    next.push_back({s});
+                }
+                children.push_back(position[i]);
+            };
+
+            n.first_child = children.size();
+            visit(n.c); // wait
+            for(const auto& s: g.AdjacentOf(n.c))
+            {
+                visit(s);
+            }
+            n.last_child = children.size();
+        }
+    }
+
+    // backward: keep only coordinates which lead to the goal at the last timestep
+    for(auto& n: nodes[cost])
+    {
+        n.leads_to_goal = n.c == goal;
+    }
+
+    for(int t = cost - 1; t >= 0; t--)
+    {
+        for(auto& n: nodes[t])
+        {
+            n.leads_to_goal = std::any_of(children.begin() + n.first_child, children.begin() + n.last_child, [&](const int j){return nodes[t + 1][j].leads_to_goal;});
+        }
+    }
+
+    for(int t = 0; t <= cost; t++)
+    {
+        for(const auto& n: nodes[t])
+        {
+            if(n.leads_to_goal)
+                layers[t].push_back(n.c);
+        }
+    }
+}
+
+bool MDD::IsSingletonAt(const Coordinate& c, const int timestep) const
+{
+    if(timestep > cost)
+        return c == goal;
+
+    const auto& layer = layers[timestep];
+    return layer.size() == 1 && layer.front() == c;
+}
\ No newline at end of file
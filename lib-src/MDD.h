@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Agent.h"
+#include "ConstraintChain.h"
+#include "Coordinate.h"
+#include "Types.h"
+#include <algorithm>
+#include <vector>
+
+class Graph;
+class InformedHeuristic;
+
+// Multi-valued decision diagram of an agent: the coordinates visited at each timestep by all of its paths of a given cost, which satisfy its constraints.
+// Once its path ends, an agent stays at its goal.
+class MDD
+{
+public:
+    MDD(const Graph& g, const Agent& a, const InformedHeuristic& ih, const ConstraintChain* constraints, int cost);
+
+    bool IsSingletonAt(const Coordinate& c, int timestep) const; // all paths visit c at timestep
+    inline int GetCost(void) const {return cost;}
+    inline size_t WidthAt(const int timestep) const {return timestep <= cost ? layers[timestep].size() : 1;}
+    inline const std::vector<Coordinate>& LayerAt(const int timestep) const {return layers[std::min(timestep, cost)];} // the last layer holds the goal only
+
+private:
+    std::vector<std::vector<Coordinate>> layers; // layers[t] := coordinates visited at timestep t
+    Coordinate goal;
+    int cost;
+};
\ No newline at end of file
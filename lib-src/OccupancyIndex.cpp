@@ -0,0 +1,71 @@
+#include "OccupancyIndex.h"
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+
+size_t OccupancyIndex::CellHasher::operator()(const Cell& cell) const noexcept
+{
+    size_t seed = Coordinate::Hasher{}(std::get<0>(cell));
+    boost::hash_combine(seed, std::get<1>(cell));
+    return seed;
+}
+
+size_t OccupancyIndex::MoveHasher::operator()(const Move& move) const noexcept
+{
+    size_t seed = Edge::Hasher{}(std::get<0>(move));
+    boost::hash_combine(seed, std::get<1>(move));
+    return seed;
+}
+
+void OccupancyIndex::Insert(const Path& p, const int tag)
+{
+    const int n = p.size();
+
+    for(int t = 0; t < n; t++)
+    {
+        const auto [iter, is_inserted] = cells.try_emplace({p[t], t}, tag);
+        if(!is_inserted)
+            Collide(iter->second, tag);
+
+        if(t + 1 < n && p[t] != p[t + 1])
+        {
+            const Edge e{p[t], p[t + 1]};
+            for(const auto& crossing_edge: e.GetCrossingEdges())
+            {
+                const auto crossing = moves.find({crossing_edge, t});
+                if(crossing != moves.end())
+                    Collide(crossing->second, tag);
+            }
+            moves.try_emplace({e, t}, tag);
+        }
+    }
+
+    if(n > 0)
+    {
+        parkings.emplace_back(p.back(), n - 1, tag);
+        makespan = std::max(makespan, n - 1);
+    }
+}
+
+std::vector<OccupancyIndex::Collision> OccupancyIndex::Collisions(void) const
+{
+    auto out = collisions;
+
+    // an agent stays at its last coordinate, any later visit of it collides
+    for(const auto& [c, arrival, tag]: parkings)
+    {
+        for(int t = arrival + 1; t <= makespan; t++)
+        {
+            const auto iter = cells.find({c, t});
+            if(iter != cells.end() && iter->second != tag)
+                out.insert(std::minmax(iter->second, tag));
+        }
+    }
+
+    return {out.begin(), out.end()};
+}
+
+void OccupancyIndex::Collide(const int tag1, const int tag2)
+{
+    if(tag1 != tag2)
+        collisions.insert(std::minmax(tag1, tag2));
+}
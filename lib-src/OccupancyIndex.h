@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Coordinate.h"
+#include "Edge.h"
+#include "Types.h"
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// <coordinate, timestep> occupancy of a set of paths, each path tagged by the group of its agent. Paths of different tags conflict iff they collide
+// in the index: at a vertex, along crossing edges, or at the coordinate an agent waits at once its path ends.
+// Paths of the same tag are assumed to be conflict-free, hence collisions between them are not reported.
+class OccupancyIndex
+{
+public:
+    using Collision = std::pair<int, int>; // <i, j> s.t i < j, tags of colliding paths
+
+    OccupancyIndex() = default;
+
+    void Insert(const Path& p, int tag);
+    std::vector<Collision> Collisions(void) const; // every colliding pair of tags, once
+
+private:
+    using Cell = std::tuple<Coordinate, int>; // <coordinate, timestep>
+    using Move = std::tuple<Edge, int>; // <traversed edge, departure timestep>
+    using Parking = std::tuple<Coordinate, int, int>; // <last coordinate of a path, its arrival timestep, tag>
+
+    struct CellHasher{size_t operator()(const Cell& cell) const noexcept;};
+    struct MoveHasher{size_t operator()(const Move& move) const noexcept;};
+
+    boost::unordered_map<Cell, int, CellHasher> cells; // cell -> tag of the first path which occupies it
+    boost::unordered_map<Move, int, MoveHasher> moves; // move -> tag of the first path which makes it
+    std::vector<Parking> parkings;
+    boost::unordered_set<Collision> collisions;
+    int makespan = 0;
+
+    void Collide(int tag1, int tag2);
+};
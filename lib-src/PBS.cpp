@@ -0,0 +1,284 @@
+#include "PBS.h"
+#include "Agent.h"
+#include "IConflict.h"
+#include "SafeIntervals.h"
+#include "Timer.h"
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <sstream>
+
+PBS::PBS(ILowLevelPlanner* llp): llp(llp){}
+
+PlanResult PBS::Plan(const Graph& g, const Agents& as, const float timeout)
+{
+    Timer timer;
+    Paths ps(as.size());
+    AgentsIndicesSet S;
+    bool is_plan_found;
+
+    timer.Start(timeout);
+
+    for(const auto& a: as)
+    {
+        if(!Agent::IsPlaceholderAgent(a))
+        {
+            S.insert(a.index);
+        }
+    }
+
+    std::tie(is_plan_found, nexpansions) = Replan(g, as, ps, S, timeout, 0);
+
+    return {is_plan_found, is_plan_found ? ps : Paths{}, nexpansions, timer.Stop()};
+}
+
+std::tuple<bool, unsigned long> PBS::Replan(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, const float timeout, const int /*current_timestep*/)
+{
+    Timer timer;
+    const size_t K = all.size();
+    std::vector<PTNode> open; // depth-first, the top of the stack is explored next
+    PTNode root;
+    bool is_plan_found = false;
+
+    timer.Start(timeout);
+    nexpansions = 0;
+
+    // the unaffected agents keep their paths, the affected ones are planned regardless of the others
+    root.paths.resize(K);
+    for(int i = 0; i < (int)K; i++)
+    {
+        if(!affected.contains(i) && !planned_paths[i].empty())
+        {
+            root.paths[i] = std::make_shared<const SegmentedPath>(planned_paths[i]);
+        }
+    }
+
+    for(const auto i: affected)
+    {
+        if(Agent::IsPlaceholderAgent(all[i]))
+            continue;
+
+        SafeIntervals si;
+        auto&& [p, low_level_nexpansions] = llp->Search(g, all[i], si);
+        nexpansions += low_level_nexpansions;
+        nreplanned += 1;
+
+        if(p.empty())
+        {
+            return {false, nexpansions};
+        }
+        root.paths[i] = std::make_shared<const SegmentedPath>(p);
+    }
+
+    for(const auto& p: root.paths)
+    {
+        root.cost += PathLength(p);
+    }
+    root.conflicts.Build(root.paths);
+    open.push_back(std::move(root));
+    ngenerated += 1;
+
+    while(!open.empty() && !timer.ExceedsRuntime() && !IsCancelled())
+    {
+        PTNode n = std::move(open.back());
+        open.pop_back();
+
+        if(n.conflicts.IsEmpty())
+        {
+            for(int i = 0; i < (int)K; i++)
+            {
+                if(n.paths[i])
+                {
+                    planned_paths[i] = n.paths[i]->Expand();
+                }
+            }
+            is_plan_found = true;
+            break;
+        }
+
+        IConflict* conflict = n.conflicts.Earliest();
+        const int a = conflict->agents_indices[0], b = conflict->agents_indices[1];
+        delete conflict;
+
+        const auto lower = Adjacency(n.priorities, K, true);
+        std::vector<PTNode> children;
+        nexpanded += 1;
+
+        for(const auto& [high, low]: {std::pair{a, b}, std::pair{b, a}})
+        {
+            const auto below = Reachable(lower, low);
+            if(std::find(below.begin(), below.end(), high) != below.end())
+                continue; // the opposite ordering is already implied
+
+            PTNode child = n;
+            child.priorities.emplace_back(high, low);
+            ngenerated += 1;
+
+            if(UpdatePlan(child, low, g, all))
+            {
+                children.push_back(std::move(child));
+            }
+            else
+            {
+                npruned += 1;
+            }
+        }
+
+        // the cheaper child is pushed last, breaking ties in favour of fewer conflicts
+        std::sort(children.begin(), children.end(), [](const PTNode& n1, const PTNode& n2){return n1.cost > n2.cost || (n1.cost == n2.cost && n1.conflicts.Count() > n2.conflicts.Count());});
+        for(auto& child: children)
+        {
+            open.push_back(std::move(child));
+        }
+    }
+
+    return {is_plan_found && !timer.ExceedsRuntime(), nexpansions};
+}
+
+bool PBS::UpdatePlan(PTNode& n, const int pushed, const Graph& g, const Agents& all)
+{
+    const size_t K = n.paths.size();
+    const auto lower = Adjacency(n.priorities, K, true);
+    const auto higher = Adjacency(n.priorities, K, false);
+    auto group = Reachable(lower, pushed);
+    group.push_back(pushed);
+
+    for(const auto i: TopologicalOrder(lower, group))
+    {
+        const auto above = Reachable(higher, i);
+
+        // agents below the pushed one are replanned only if they collide with an agent above them
+        const bool is_colliding = i == pushed || std::any_of(above.begin(), above.end(), [&n, i](const auto j)
+        {
+            if(!n.paths[j] || !n.paths[i])
+                return false;
+            IConflict* conflict = ConflictTable::EarliestBetween(j, i, *n.paths[j], *n.paths[i]);
+            const bool is_conflict = conflict != nullptr;
+            delete conflict;
+            return is_conflict;
+        });
+
+        if(!is_colliding)
+            continue;
+
+        SafeIntervals si;
+        for(const auto j: above)
+        {
+            if(n.paths[j])
+            {
+                si.Add(*n.paths[j]);
+            }
+        }
+
+        auto&& [p, low_level_nexpansions] = llp->Search(g, all[i], si);
+        nexpansions += low_level_nexpansions;
+        nreplanned += 1;
+
+        if(p.empty())
+        {
+            return false;
+        }
+
+        n.cost -= PathLength(n.paths[i]);
+        n.paths[i] = std::make_shared<const SegmentedPath>(p);
+        n.cost += PathLength(n.paths[i]);
+        n.conflicts.Update(i, n.paths);
+    }
+
+    return true;
+}
+
+std::vector<std::vector<int>> PBS::Adjacency(const Priorities& priorities, const size_t K, const bool is_downward)
+{
+    std::vector<std::vector<int>> adj(K);
+
+    for(const auto& [high, low]: priorities)
+    {
+        if(is_downward)
+            adj[high].push_back(low);
+        else
+            adj[low].push_back(high);
+    }
+
+    return adj;
+}
+
+std::vector<int> PBS::Reachable(const std::vector<std::vector<int>>& adj, const int from)
+{
+    std::vector<int> reached;
+    std::vector<bool> visited(adj.size(), false);
+    std::deque<int> q{from};
+    visited[from] = true;
+
+    while(!q.empty())
+    {
+        const int u = q.front();
+        q.pop_front();
+
+        for(const auto v: adj[u])
+        {
+            if(!visited[v])
+            {
+                visited[v] = true;
+                reached.push_back(v);
+                q.push_back(v);
+            }
+        }
+    }
+
+    return reached;
+}
+
+std::vector<int> PBS::TopologicalOrder(const std::vector<std::vector<int>>& lower, const std::vector<int>& group)
+{
+    std::vector<int> order, indegree(lower.size(), 0);
+    std::vector<bool> is_member(lower.size(), false);
+
+    for(const auto i: group)
+    {
+        is_member[i] = true;
+    }
+    for(const auto i: group)
+    {
+        for(const auto j: lower[i])
+        {
+            indegree[j] += is_member[j];
+        }
+    }
+    for(const auto i: group)
+    {
+        if(indegree[i] == 0)
+        {
+            order.push_back(i);
+        }
+    }
+
+    // the priorities are acyclic, hence every member is eventually ordered
+    for(size_t k = 0; k < order.size(); k++)
+    {
+        for(const auto j: lower[order[k]])
+        {
+            if(is_member[j] && --indegree[j] == 0)
+            {
+                order.push_back(j);
+            }
+        }
+    }
+
+    return order;
+}
+
+long PBS::PathLength(const SharedSegmentedPath& p)
+{
+    return (p && !p->IsEmpty()) ? p->Length() - 1 : 0;
+}
+
+std::string PBS::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#Generated PT nodes: " << ngenerated << '\n';
+    ss << "#Expanded PT nodes: " << nexpanded << '\n';
+    ss << "#Pruned PT nodes: " << npruned << '\n';
+    ss << "#Low-level searches: " << nreplanned << '\n';
+    return ss.str() + (llp ? llp->GetStats() : "");
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "ConflictTable.h"
+#include "Graph.h"
+#include "IHighLevelPlanner.h"
+#include "ILowLevelPlanner.h"
+#include "SegmentedPath.h"
+#include "Types.h"
+#include <utility>
+#include <vector>
+
+class ILowLevelPlanner;
+class IPolicy;
+class InformedHeuristic;
+
+// Priority-based search (PBS). A depth-first search over partial priority orderings of the agents. The root plans each agent independently,
+// a node resolves its earliest conflict by two children, each ordering one agent of the conflict above the other. A child replans the lower agent
+// and then, in topological order, every agent below it that collides with an agent above it. An agent is planned against the paths of all the agents
+// above it only. A child whose low-level search fails is pruned, the cheaper child is explored first.
+// Upon replanning, the root keeps the paths of the unaffected agents, hence conflicts are resolved only around the affected agents.
+class PBS: public IHighLevelPlanner
+{
+public:
+    PBS(ILowLevelPlanner* llp);
+    virtual ~PBS() {delete llp; llp = nullptr;}
+
+    PlanResult Plan(const Graph& g, const Agents& as, float timeout) override;
+    std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) override;
+
+    inline void Init(IPolicy* policy, const InformedHeuristic& ih, size_t /*k*/) override {llp->Init(policy, ih);}
+    inline std::string GetName(void) const override {return "PBS+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    std::string GetStats(void) const override;
+
+protected:
+    using Priorities = std::vector<std::pair<int, int>>; // <higher, lower> pairs, in the order they were added along the branch
+
+    struct PTNode
+    {
+        SharedSegmentedPaths paths; // paths of agents which are not replanned are shared with the parent node
+        ConflictTable conflicts;
+        Priorities priorities;
+        size_t cost = 0;
+    };
+
+    ILowLevelPlanner* llp;
+    unsigned long nexpansions = 0; // low-level expansions of the current call
+    unsigned long ngenerated = 0, nexpanded = 0, npruned = 0, nreplanned = 0;
+
+    bool UpdatePlan(PTNode& n, int pushed, const Graph& g, const Agents& all);
+    static std::vector<std::vector<int>> Adjacency(const Priorities& priorities, size_t K, bool is_downward);
+    static std::vector<int> Reachable(const std::vector<std::vector<int>>& adj, int from); // excluding from
+    static std::vector<int> TopologicalOrder(const std::vector<std::vector<int>>& lower, const std::vector<int>& group);
+    static long PathLength(const SharedSegmentedPath& p);
+};
\ No newline at end of file
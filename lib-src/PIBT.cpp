@@ -0,0 +1,592 @@
+#include "PIBT.h"
+#include "Graph.h"
+#include "InformedHeuristic.h"
+#include "Timer.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <sstream>
+
+PIBT::PIBT(const bool is_lazy_search): is_lazy_search(is_lazy_search), gen(std::random_device{}()){}
+
+void PIBT::Init(IPolicy* /*policy*/, const InformedHeuristic& ih, const size_t /*k*/)
+{
+    this->ih = &ih;
+    exact.clear();
+    previous_unusable.clear();
+}
+
+PlanResult PIBT::Plan(const Graph& g, const Agents& as, const float timeout)
+{
+    Timer timer;
+    Paths paths;
+
+    timer.Start(timeout);
+    const bool is_plan_found = Solve(g, as, paths, timeout);
+
+    return {is_plan_found, is_plan_found ? paths : Paths{}, nexpansions, timer.Stop()};
+}
+
+// configurations are planned for all the agents at once, hence all of them are replanned from their current locations, rather than the affected only
+std::tuple<bool, unsigned long> PIBT::Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& /*affected*/, const float timeout, const int /*current_timestep*/)
+{
+    Paths paths;
+    const bool is_plan_found = Solve(g, all, paths, timeout);
+
+    if(is_plan_found)
+    {
+        ongoing_plans = std::move(paths);
+    }
+
+    return {is_plan_found, nexpansions};
+}
+
+bool PIBT::Solve(const Graph& g, const Agents& all, Paths& paths, const float timeout)
+{
+    Nodes nodes;
+    nexpansions = 0;
+
+    if(!Build(g, all))
+    {
+        return false;
+    }
+
+    const auto goal = is_lazy_search ? LazySearch(nodes, timeout) : GreedySearch(nodes, timeout);
+
+    if(goal)
+    {
+        paths = Backtrack(goal, all.size());
+    }
+
+    return goal != nullptr;
+}
+
+bool PIBT::Build(const Graph& g, const Agents& all)
+{
+    static constexpr int moves[8][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+    const int N = g.GetNumberOfIndices(), ncolumns = g.GetNumberOfColumns();
+    const auto& V = g.GetVertices();
+    Moves unusable, removed, added; // moves between neighboring vertices which are not edges of finite weight, e.g, unobserved maybe blocked edges
+    std::vector<bool> is_vertex(N, false);
+    bool is_diagonal = false;
+
+    agents.clear();
+    starts.clear();
+    goals.clear();
+    dist.clear();
+    adj.assign(N, {});
+    radj.assign(N, {});
+    coordinates.assign(N, Coordinate());
+    ih_indices.assign(N, -1);
+    occupied_now.assign(N, -1);
+    occupied_next.assign(N, -1);
+    is_affected.assign(N, false);
+
+    for(const auto& u: V)
+    {
+        const int i = g.IndexOf(u);
+        coordinates[i] = u;
+        ih_indices[i] = ih->IndexOf(u);
+        is_vertex[i] = true;
+    }
+
+    for(const auto& [e, w]: g.GetWeights())
+    {
+        if(!e.IsSelfLoopEdge() && w < INF)
+        {
+            const int u = g.IndexOf(e.source), v = g.IndexOf(e.destination);
+            adj[u].push_back(v);
+            radj[v].push_back(u);
+            is_diagonal = is_diagonal || e.IsDiagonalEdge();
+        }
+    }
+
+    for(int i = 0; i < N; i++)
+    {
+        for(int k = 0; k < (is_diagonal ? 8 : 4) && is_vertex[i]; k++)
+        {
+            const int row = i / ncolumns + moves[k][0], column = i % ncolumns + moves[k][1], j = row * ncolumns + column;
+            if(column >= 0 && column < ncolumns && j >= 0 && j < N && is_vertex[j] && std::find(adj[i].begin(), adj[i].end(), j) == adj[i].end())
+            {
+                unusable.emplace_back(i, j);
+            }
+        }
+    }
+
+    // the graph changes between calls by the observed edges only
+    std::sort(unusable.begin(), unusable.end());
+    std::set_difference(unusable.begin(), unusable.end(), previous_unusable.begin(), previous_unusable.end(), std::back_inserter(removed));
+    std::set_difference(previous_unusable.begin(), previous_unusable.end(), unusable.begin(), unusable.end(), std::back_inserter(added));
+
+    for(const auto& a: all)
+    {
+        if(Agent::IsPlaceholderAgent(a))
+        {
+            continue;
+        }
+
+        const auto table = ih->DistancesTo(a.goal);
+        if(!table || table->empty() || !V.contains(a.start))
+        {
+            return false;
+        }
+
+        const int goal = g.IndexOf(a.goal);
+        auto iter = exact.find(goal);
+
+        agents.push_back(a.index);
+        starts.push_back(g.IndexOf(a.start));
+        goals.push_back(goal);
+
+        if(iter != exact.end())
+        {
+            Repair(iter->second, removed, added);
+            dist.push_back(&iter->second);
+        }
+        else if(IsExact(*table, unusable))
+        {
+            dist.push_back(table);
+        }
+        else
+        {
+            auto& recomputed = exact[goal];
+            recomputed.assign(table->size(), INF);
+            ComputeDistances(goal, recomputed);
+            dist.push_back(&recomputed);
+        }
+    }
+
+    // a table which is not kept exact now can not be kept exact in the next call
+    for(auto iter = exact.begin(); iter != exact.end();)
+    {
+        iter = std::find(goals.begin(), goals.end(), iter->first) == goals.end() ? exact.erase(iter) : std::next(iter);
+    }
+
+    previous_unusable = std::move(unusable);
+    to.assign(agents.size(), -1);
+
+    return true;
+}
+
+std::unique_ptr<PIBT::HighLevelNode> PIBT::CreateNode(Configuration&& q, const HighLevelNode* parent)
+{
+    auto n = std::make_unique<HighLevelNode>();
+    const size_t K = q.size();
+    float max_distance = 0;
+
+    n->q = std::move(q);
+    n->parent = parent;
+    n->priorities.resize(K);
+    n->order.resize(K);
+
+    for(size_t i = 0; i < K && !parent; i++)
+    {
+        max_distance = std::max(max_distance, DistanceOf(i, n->q[i]));
+    }
+
+    for(size_t i = 0; i < K; i++)
+    {
+        if(parent)
+        {
+            // an agent away from its goal gains priority, an agent at its goal drops back to its tie-breaker
+            const float p = parent->priorities[i];
+            n->priorities[i] = n->q[i] != goals[i] ? p + 1 : p - std::floor(p);
+        }
+        else
+        {
+            n->priorities[i] = DistanceOf(i, n->q[i]) / (max_distance + 1);
+        }
+    }
+
+    std::iota(n->order.begin(), n->order.end(), 0);
+    std::stable_sort(n->order.begin(), n->order.end(), [&n](const int i, const int j){return n->priorities[i] > n->priorities[j];});
+    n->tree.emplace_back();
+
+    return n;
+}
+
+const PIBT::HighLevelNode* PIBT::LazySearch(Nodes& nodes, const float timeout)
+{
+    Timer timer;
+    Explored explored;
+    std::vector<HighLevelNode*> open; // depth-first
+    const size_t K = agents.size();
+
+    timer.Start(timeout);
+    nodes.push_back(CreateNode(Configuration(starts), nullptr));
+    explored.emplace(nodes.back()->q, nodes.back().get());
+    open.push_back(nodes.back().get());
+
+    while(!open.empty() && !timer.ExceedsRuntime() && !IsCancelled())
+    {
+        auto n = open.back();
+
+        if(n->q == goals)
+        {
+            return n;
+        }
+
+        if(n->tree.empty()) // every successor of n was tried
+        {
+            open.pop_back();
+            continue;
+        }
+
+        const auto c = std::move(n->tree.front());
+        n->tree.pop_front();
+        nexpansions += 1;
+
+        if(c.who.size() < K)
+        {
+            // the successors of c fix the next vertex of the next agent in order as well, to each of its options
+            const int i = n->order[c.who.size()];
+            std::vector<int> options(adj[n->q[i]]);
+            options.push_back(n->q[i]);
+            std::shuffle(options.begin(), options.end(), gen);
+
+            for(const auto v: options)
+            {
+                auto& successor = n->tree.emplace_back(c);
+                successor.who.push_back(i);
+                successor.where.push_back(v);
+            }
+        }
+
+        if(!Step(n->q, n->order, c))
+        {
+            nfailures += 1;
+            continue;
+        }
+
+        const auto iter = explored.find(to);
+        if(iter != explored.end())
+        {
+            // revisit the known configuration, the next time it is expanded more agents are fixed
+            nrevisits += 1;
+            open.push_back(iter->second);
+            continue;
+        }
+
+        ngenerated += 1;
+        nodes.push_back(CreateNode(Configuration(to), n));
+        explored.emplace(nodes.back()->q, nodes.back().get());
+        open.push_back(nodes.back().get());
+    }
+
+    return nullptr;
+}
+
+const PIBT::HighLevelNode* PIBT::GreedySearch(Nodes& nodes, const float timeout)
+{
+    Timer timer;
+    const LowLevelNode none;
+
+    timer.Start(timeout);
+    nodes.push_back(CreateNode(Configuration(starts), nullptr));
+
+    while(nodes.size() < max_greedy_timesteps && !timer.ExceedsRuntime() && !IsCancelled())
+    {
+        const auto n = nodes.back().get();
+
+        if(n->q == goals)
+        {
+            return n;
+        }
+
+        nexpansions += 1;
+        if(!Step(n->q, n->order, none))
+        {
+            nfailures += 1;
+            return nullptr;
+        }
+
+        ngenerated += 1;
+        nodes.push_back(CreateNode(Configuration(to), n));
+        nodes.back()->tree.clear();
+    }
+
+    return nullptr;
+}
+
+bool PIBT::Step(const Configuration& q, const std::vector<int>& order, const LowLevelNode& constraints)
+{
+    const size_t K = q.size();
+    bool is_valid = true;
+
+    from = q;
+    std::fill(to.begin(), to.end(), -1);
+
+    for(size_t i = 0; i < K; i++)
+    {
+        occupied_now[from[i]] = i;
+    }
+
+    for(size_t k = 0; k < constraints.who.size() && is_valid; k++)
+    {
+        const int i = constraints.who[k], v = constraints.where[k], j = occupied_now[v];
+
+        // vertex or swapping conflict between fixed agents
+        if(occupied_next[v] != -1 || (j != -1 && j != i && to[j] == from[i]))
+        {
+            is_valid = false;
+        }
+        else
+        {
+            Reserve(v, i);
+        }
+    }
+
+    for(auto iter = order.begin(); iter != order.end() && is_valid; iter++)
+    {
+        if(to[*iter] == -1 && !Push(*iter))
+        {
+            is_valid = false;
+        }
+    }
+
+    for(const auto v: reserved)
+    {
+        occupied_next[v] = -1;
+    }
+    reserved.clear();
+
+    for(size_t i = 0; i < K; i++)
+    {
+        occupied_now[from[i]] = -1;
+    }
+
+    return is_valid;
+}
+
+bool PIBT::Push(const int i)
+{
+    std::vector<int> candidates(adj[from[i]]);
+    candidates.push_back(from[i]);
+
+    // closest to the goal first, ties are broken at random
+    std::shuffle(candidates.begin(), candidates.end(), gen);
+    std::stable_sort(candidates.begin(), candidates.end(), [this, i](const int u, const int v){return DistanceOf(i, u) < DistanceOf(i, v);});
+
+    for(const auto v: candidates)
+    {
+        const int j = occupied_now[v];
+
+        // vertex or swapping conflict
+        if(occupied_next[v] != -1 || (j != -1 && to[j] == from[i]))
+        {
+            continue;
+        }
+
+        Reserve(v, i);
+
+        // v is free, or j moves away already, or j inherits the priority of i and is pushed away
+        if(j == -1 || j == i || to[j] != -1 || Push(j))
+        {
+            return true;
+        }
+    }
+
+    // i can not move, stay
+    Reserve(from[i], i);
+    return false;
+}
+
+void PIBT::Reserve(const int v, const int i)
+{
+    occupied_next[v] = i;
+    to[i] = v;
+    reserved.push_back(v);
+}
+
+Paths PIBT::Backtrack(const HighLevelNode* goal, const size_t K) const
+{
+    std::vector<const Configuration*> qs;
+    Paths paths(K);
+
+    for(auto n = goal; n; n = n->parent)
+    {
+        qs.push_back(&n->q);
+    }
+    std::reverse(qs.begin(), qs.end());
+
+    for(size_t i = 0; i < agents.size(); i++)
+    {
+        // the path ends once the agent reaches its goal for the last time
+        size_t last = qs.size() - 1;
+        while(last > 0 && (*qs[last - 1])[i] == goals[i])
+        {
+            last--;
+        }
+
+        auto& p = paths[agents[i]];
+        for(size_t t = 0; t <= last; t++)
+        {
+            p.push_back(coordinates[(*qs[t])[i]]);
+        }
+    }
+
+    return paths;
+}
+
+// the tables of ih are computed over all the moves of the map with unit weights, hence they bound the distances over the current graph from below.
+// such a table is exact as long as every vertex whose shortest move toward the goal is unusable, has another usable shortest move
+bool PIBT::IsExact(const std::vector<float>& table, const Moves& unusable) const
+{
+    return std::none_of(unusable.begin(), unusable.end(), [this, &table](const auto& e){
+        const auto du = table[ih_indices[e.first]], dv = table[ih_indices[e.second]];
+        const auto& successors = adj[e.first];
+        return du < INF && du == dv + 1 && std::none_of(successors.begin(), successors.end(), [this, &table, du](const int w){return table[ih_indices[w]] == du - 1;});
+    });
+}
+
+void PIBT::ComputeDistances(const int goal, std::vector<float>& table)
+{
+    table[ih_indices[goal]] = 0;
+    q.assign(1, goal);
+
+    for(size_t k = 0; k < q.size(); k++)
+    {
+        const int v = q[k];
+
+        for(const auto u: radj[v])
+        {
+            if(table[ih_indices[u]] >= INF)
+            {
+                table[ih_indices[u]] = table[ih_indices[v]] + 1;
+                q.push_back(u);
+            }
+        }
+    }
+
+    nrecomputed += 1;
+}
+
+// keeps a table which is exact over the graph of the previous call, exact over the current graph. the moves which became unusable may only increase
+// distances, hence only the vertices left without a shortest move toward the goal, and the vertices which relied on them, are recomputed. then the
+// moves which became usable may only decrease distances, hence only the vertices getting closer to the goal are visited
+void PIBT::Repair(std::vector<float>& table, const Moves& removed, const Moves& added)
+{
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    const auto d = [this, &table](const int v) -> float& {return table[ih_indices[v]];};
+    const auto is_previous_move = [&added](const int u, const int v){return !std::binary_search(added.begin(), added.end(), std::make_pair(u, v));};
+    const auto is_supported = [this, &d, &is_previous_move](const int u)
+    {
+        return std::any_of(adj[u].begin(), adj[u].end(), [this, &d, &is_previous_move, u](const int w){return !is_affected[w] && d(w) == d(u) - 1 && is_previous_move(u, w);});
+    };
+
+    q.clear();
+    for(const auto& [u, v]: removed)
+    {
+        if(d(u) < INF && d(u) == d(v) + 1)
+        {
+            open.emplace(d(u), u);
+        }
+    }
+
+    // in increasing distance, a vertex is affected once all of its shortest moves are unusable or lead to affected vertices
+    while(!open.empty())
+    {
+        const auto [du, u] = open.top();
+        open.pop();
+
+        if(is_affected[u] || is_supported(u))
+        {
+            continue;
+        }
+
+        is_affected[u] = true;
+        q.push_back(u);
+
+        for(const auto p: radj[u])
+        {
+            if(!is_affected[p] && d(p) == du + 1)
+            {
+                open.emplace(du + 1, p);
+            }
+        }
+    }
+
+    nrepaired += !q.empty();
+
+    for(const auto u: q)
+    {
+        d(u) = INF;
+    }
+
+    for(const auto u: q)
+    {
+        for(const auto w: adj[u])
+        {
+            if(!is_affected[w] && is_previous_move(u, w) && d(w) + 1 < d(u))
+            {
+                d(u) = d(w) + 1;
+            }
+        }
+
+        if(d(u) < INF)
+        {
+            open.emplace(d(u), u);
+        }
+    }
+
+    while(!open.empty())
+    {
+        const auto [du, u] = open.top();
+        open.pop();
+
+        for(const auto p: radj[u])
+        {
+            if(du == d(u) && is_affected[p] && is_previous_move(p, u) && du + 1 < d(p))
+            {
+                d(p) = du + 1;
+                open.emplace(du + 1, p);
+            }
+        }
+    }
+
+    for(const auto u: q)
+    {
+        is_affected[u] = false;
+    }
+
+    // label-correcting through the moves which became usable
+    q.clear();
+    for(const auto& [u, v]: added)
+    {
+        if(d(u) > d(v) + 1)
+        {
+            d(u) = d(v) + 1;
+            q.push_back(u);
+        }
+    }
+
+    nrepaired += !q.empty();
+
+    for(size_t k = 0; k < q.size(); k++)
+    {
+        const int v = q[k];
+
+        for(const auto u: radj[v])
+        {
+            if(d(u) > d(v) + 1)
+            {
+                d(u) = d(v) + 1;
+                q.push_back(u);
+            }
+        }
+    }
+}
+
+std::string PIBT::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#Configurations generated: " << ngenerated << '\n';
+    ss << "#Configurations revisited: " << nrevisits << '\n';
+    ss << "#Failed configuration generations: " << nfailures << '\n';
+    ss << "#Distance tables recomputed: " << nrecomputed << '\n';
+    ss << "#Distance table repairs: " << nrepaired << '\n';
+    return ss.str();
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "IHighLevelPlanner.h"
+#include "Types.h"
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered_map.hpp>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+// Priority inheritance with backtracking (PIBT). Agents move one timestep at a time, in decreasing priority. Each agent heads to the unreserved
+// neighbor closest to its goal. An agent which occupies that neighbor inherits the priority and has to move away first, otherwise the move is revoked.
+// The priority of an agent grows each timestep it is not at its goal. PIBT alone is incomplete, hence it is optionally used as the configuration
+// generator of LaCAM: a depth-first search over configurations, which lazily fixes the next vertex of more and more agents whenever a configuration
+// is revisited, until the goal configuration is found or the search space is exhausted.
+// Distances to the goals are read from the dense tables of the informed heuristic, which count the unobserved edges as open. Where such a table is not
+// exact over the current graph, it is recomputed once and then repaired incrementally as edges are observed.
+class PIBT: public IHighLevelPlanner
+{
+public:
+    PIBT(bool is_lazy_search=true);
+    virtual ~PIBT() = default;
+
+    PlanResult Plan(const Graph& g, const Agents& as, float timeout) override;
+    std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) override;
+
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    inline std::string GetName(void) const override {return is_lazy_search ? "LaCAM(PIBT)" : "PIBT";}
+    std::string GetStats(void) const override;
+
+protected:
+    using Configuration = std::vector<int>; // vertex index of each agent
+    using Moves = std::vector<std::pair<int, int>>;
+
+    // fixes the next vertex of the first agents in the order of a high-level node
+    struct LowLevelNode
+    {
+        std::vector<int> who, where;
+    };
+
+    struct HighLevelNode
+    {
+        Configuration q;
+        const HighLevelNode* parent;
+        std::vector<float> priorities;
+        std::vector<int> order; // agents by decreasing priority
+        std::deque<LowLevelNode> tree; // low-level nodes yet to be used to generate a successor of q
+    };
+
+    struct ConfigurationHasher{size_t operator() (const Configuration& q) const noexcept {return boost::hash_range(q.begin(), q.end());}};
+    using Nodes = std::vector<std::unique_ptr<HighLevelNode>>;
+    using Explored = boost::unordered_map<Configuration, HighLevelNode*, ConfigurationHasher>;
+
+    static constexpr size_t max_greedy_timesteps = 10000; // PIBT alone may livelock
+
+    bool is_lazy_search;
+    const InformedHeuristic* ih = nullptr;
+    std::mt19937 gen;
+    unsigned long nexpansions = 0, ngenerated = 0, nrevisits = 0, nfailures = 0, nrecomputed = 0, nrepaired = 0;
+
+    // the instance being solved, over dense vertex indices
+    std::vector<int> agents; // global index of each non-placeholder agent
+    std::vector<std::vector<int>> adj, radj; // vertex index -> successors, predecessors. over usable (finite weight) edges only
+    std::vector<Coordinate> coordinates; // vertex index -> coordinate
+    std::vector<int> ih_indices; // vertex index -> index in the distance tables of ih
+    std::vector<const std::vector<float>*> dist; // distance-to-go table of each agent
+    boost::unordered_map<int, std::vector<float>> exact; // goal -> table recomputed over the graph, where the table of the goal in ih is not exact
+    Moves previous_unusable; // unusable moves of the graph of the previous call, sorted
+    Configuration starts, goals;
+
+    // the step being generated
+    std::vector<int> occupied_now, occupied_next; // vertex index -> agent, -1 if none
+    std::vector<int> reserved; // vertices of occupied_next to be reset
+    std::vector<int> q; // vertices of a distance table to be updated
+    std::vector<bool> is_affected; // vertex index -> whether its distance is recomputed by the repair of a table
+    Configuration from, to;
+
+    bool Solve(const Graph& g, const Agents& all, Paths& paths, float timeout);
+    bool Build(const Graph& g, const Agents& all);
+    std::unique_ptr<HighLevelNode> CreateNode(Configuration&& q, const HighLevelNode* parent);
+    const HighLevelNode* LazySearch(Nodes& nodes, float timeout);
+    const HighLevelNode* GreedySearch(Nodes& nodes, float timeout);
+    bool Step(const Configuration& q, const std::vector<int>& order, const LowLevelNode& constraints);
+    bool Push(int i);
+    void Reserve(int v, int i);
+    Paths Backtrack(const HighLevelNode* goal, size_t K) const;
+    bool IsExact(const std::vector<float>& table, const Moves& unusable) const;
+    void ComputeDistances(int goal, std::vector<float>& table);
+    void Repair(std::vector<float>& table, const Moves& removed, const Moves& added);
+    inline float DistanceOf(int i, int v) const {return (*dist[i])[ih_indices[v]];}
+};
\ No newline at end of file
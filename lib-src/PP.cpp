@@ -1,17 +1,58 @@
 #include "PP.h"
 #include "Agent.h"
+#include "ConflictTable.h"
+#include "IConflict.h"
 #include "InformedHeuristic.h"
 #include "SafeIntervals.h"
 #include "Timer.h"
 #include "Types.h"
+#include "Utils.h"
 #include <cassert>
 #include <iterator>
 #include <utility>
 #include <algorithm>
 #include "ILowLevelPlanner.h"
 #include <algorithm>
+#include <future>
+#include <sstream>
+#include <thread>
 
-PP::PP(ILowLevelPlanner* llp, const int nshuffles): llp(llp), nshuffles(nshuffles), rd(), gen(rd()), ih(nullptr), nexpansions(0){}
+PP::PP(ILowLevelPlanner* llp, const int nshuffles, const int window): llp(llp), nshuffles(std::max(nshuffles, 1)), rd(), gen(rd()), ih(nullptr), nexpansions(0), window(std::max(window, 1)){}
+
+void PP::Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k)
+{
+    this->ih = &ih;
+    llp->Init(policy, ih);
+
+    pool.reset();
+    forks.clear();
+    restart_stats.assign(nshuffles, {});
+
+    if(nshuffles > 1)
+    {
+        const int nworkers = std::min<int>(nshuffles, std::max(1u, std::thread::hardware_concurrency()));
+        for(int i = 0; i < nworkers; i++)
+        {
+            forks.emplace_back(new PP(llp->Clone(), 1));
+            forks.back()->Init(policy, ih, k);
+            forks.back()->SetCancellationFlag(&is_done);
+        }
+        pool = std::make_unique<WorkStealingPool>(nworkers);
+    }
+
+    speculation_pool.reset();
+    planners.clear();
+
+    if(window > 1)
+    {
+        for(int i = 0; i < window; i++)
+        {
+            planners.emplace_back(llp->Clone());
+            planners.back()->Init(policy, ih);
+        }
+        speculation_pool = std::make_unique<WorkStealingPool>(window);
+    }
+}
 
 PlanResult PP::Plan(const Graph& g, const Agents& as, const float timeout)
 {
@@ -40,8 +81,122 @@ PlanResult PP::Plan(const Graph& g, const Agents& as, const float timeout)
 
 std::tuple<bool, unsigned long> PP::Replan(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, const float timeout, const int current_timestep)
 {
+    if(pool)
+    {
+        return Race(g, all, planned_paths, affected, timeout);
+    }
+
+    nexpansions = 0;
+    const bool is_plan_found = Solve(g, all, planned_paths, affected, timeout);
+    return {is_plan_found, nexpansions};
+}
+
+std::tuple<bool, unsigned long> PP::Race(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, const float timeout)
+{
+    struct Outcome
+    {
+        bool is_started = false, is_plan_found = false, is_cancelled = false;
+        Paths paths;
+        unsigned long nexpansions = 0;
+        double runtime = 0;
+    };
+
     Timer timer;
+    std::vector<std::promise<Outcome>> outcomes(nshuffles);
+    std::vector<std::future<Outcome>> results;
+
+    timer.Start(timeout);
+    is_done = false;
+
+    for(auto& outcome: outcomes)
+    {
+        results.push_back(outcome.get_future());
+    }
+
+    // each restart seeds the generator of the fork it runs on from the generator of this planner, restarts which were not started once a plan
+    // is complete are skipped
+    for(int r = 0; r < nshuffles; r++)
+    {
+        pool->Submit([this, r, seed = gen(), &g, &all, &planned_paths, &affected, &outcomes, &timer](const int worker_index)
+        {
+            Outcome o;
+
+            if(!is_done && !timer.ExceedsRuntime())
+            {
+                Timer restart_timer;
+                auto& fork = forks[worker_index];
+
+                restart_timer.Start();
+                o.is_started = true;
+                fork->gen.seed(seed);
+                fork->nexpansions = 0;
+                o.paths = planned_paths;
+                o.is_plan_found = fork->Solve(g, all, o.paths, affected, timer.GetRemainingRuntime());
+                o.nexpansions = fork->nexpansions;
+                o.runtime = restart_timer.Stop();
+
+                if(o.is_plan_found)
+                {
+                    is_done = true;
+                }
+            }
+
+            o.is_cancelled = o.is_started && !o.is_plan_found && is_done;
+            outcomes[r].set_value(std::move(o));
+        });
+    }
+
+    int winner = -1;
+    long best_cost = 0;
     nexpansions = 0;
+
+    // a cancellation of this planner is passed on to the running restarts
+    for(auto& result: results)
+    {
+        while(result.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready)
+        {
+            if(IsCancelled())
+            {
+                is_done = true;
+            }
+        }
+    }
+
+    for(int r = 0; r < nshuffles; r++)
+    {
+        auto o = results[r].get();
+        auto& s = restart_stats[r];
+
+        s.nstarted += o.is_started;
+        s.ncompleted += o.is_plan_found;
+        s.ncancelled += o.is_cancelled;
+        s.nexpansions += o.nexpansions;
+        s.runtime += o.runtime;
+        nexpansions += o.nexpansions;
+
+        if(o.is_plan_found)
+        {
+            const long cost = ObjectiveFunction::SumOfCost(o.paths);
+            if(winner == -1 || cost < best_cost)
+            {
+                winner = r;
+                best_cost = cost;
+                planned_paths = std::move(o.paths);
+            }
+        }
+    }
+
+    if(winner != -1)
+    {
+        restart_stats[winner].nwon += 1;
+    }
+
+    return {winner != -1 && !timer.ExceedsRuntime(), nexpansions};
+}
+
+bool PP::Solve(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, const float timeout)
+{
+    Timer timer;
     const int N = std::max(1, static_cast<int>(0.1 * all.size()));
     AgentsIndicesSet blocked, blocking, blocking_subset;
 
@@ -49,12 +204,12 @@ std::tuple<bool, unsigned long> PP::Replan(const Graph& g, const Agents& all, Pa
 
     blocked = ReplanGroup(g, all, planned_paths, affected);
 
-    while(!blocked.empty() && !timer.ExceedsRuntime())
+    while(!blocked.empty() && !timer.ExceedsRuntime() && !IsCancelled())
     {
         blocking = BlockingAgents(all, blocked, planned_paths);
         blocking_subset.clear();
 
-        while(!blocked.empty() && !timer.ExceedsRuntime())
+        while(!blocked.empty() && !timer.ExceedsRuntime() && !IsCancelled())
         {
             std::sample(blocking.begin(), blocking.end(), std::inserter(blocking_subset, blocking_subset.begin()), N, gen);
             std::for_each(blocking_subset.begin(), blocking_subset.end(), [&planned_paths, &blocking](const auto i){planned_paths[i].clear(); blocking.erase(i);});
@@ -68,16 +223,24 @@ std::tuple<bool, unsigned long> PP::Replan(const Graph& g, const Agents& all, Pa
         blocked = ReplanGroup(g, all, planned_paths, blocking_subset);
     }
 
-    return {blocked.empty() && !timer.ExceedsRuntime(), nexpansions};
+    return blocked.empty() && !timer.ExceedsRuntime() && !IsCancelled();
 }
 
 AgentsIndicesSet PP::ReplanGroup(const Graph& g, const Agents& all, Paths& planned_paths, AgentsIndicesSet to_replan)
 {
+    if(speculation_pool)
+    {
+        return ReplanGroupSpeculatively(g, all, planned_paths, std::move(to_replan));
+    }
+
     std::for_each(to_replan.begin(), to_replan.end(), [&planned_paths](const auto i){planned_paths[i].clear();});
     SafeIntervals si(planned_paths);
     
     for(auto&& a: Shuffle(all, to_replan))
     {
+        if(IsCancelled())
+            break;
+
         auto&& [p, low_level_nexpansions] = llp->Search(g, a, si);
         nexpansions += low_level_nexpansions;
 
@@ -92,35 +255,131 @@ AgentsIndicesSet PP::ReplanGroup(const Graph& g, const Agents& all, Paths& plann
     return to_replan;
 }
 
+AgentsIndicesSet PP::ReplanGroupSpeculatively(const Graph& g, const Agents& all, Paths& planned_paths, AgentsIndicesSet to_replan)
+{
+    using Result = std::tuple<Path, unsigned long>;
+
+    std::for_each(to_replan.begin(), to_replan.end(), [&planned_paths](const auto i){planned_paths[i].clear();});
+    SafeIntervals si(planned_paths);
+    const auto order = Shuffle(all, to_replan);
+
+    // each worker searches a replica of the reservations of its own, brought up to date with the paths committed since it was last used.
+    // Searches only read the reservations, hence a replica is copied once per group rather than once per search
+    std::vector<SafeIntervals> replicas(window);
+    std::vector<int> nsynced(window, -1); // number of committed paths added to each replica, -1 if it was not copied yet
+    std::vector<int> log; // agents whose paths were committed, in order
+
+    for(size_t first = 0; first < order.size() && !IsCancelled(); first += window)
+    {
+        const size_t n = std::min<size_t>(window, order.size() - first);
+        std::vector<std::promise<Result>> speculations(n);
+        std::vector<std::future<Result>> results;
+        SegmentedPaths committed; // paths committed in this window so far
+
+        // the reservations, the committed paths and their log are left untouched until all speculations of the window are done
+        for(size_t k = 0; k < n; k++)
+        {
+            results.push_back(speculations[k].get_future());
+            speculation_pool->Submit([this, k, &g, &a = order[first + k], &si, &planned_paths, &replicas, &nsynced, &log, &speculations](const int worker_index)
+            {
+                auto& replica = replicas[worker_index];
+                auto& synced = nsynced[worker_index];
+
+                if(synced < 0)
+                {
+                    replica = si;
+                }
+                else
+                {
+                    for(int i = synced; i < (int)log.size(); i++)
+                    {
+                        replica.Add(planned_paths[log[i]]);
+                    }
+                }
+                synced = log.size();
+
+                speculations[k].set_value(planners[worker_index]->Search(g, a, replica));
+            });
+        }
+
+        // all speculations of the window are done before the first commit, since the workers read the reservations and the log
+        std::for_each(results.begin(), results.end(), [](const auto& result){result.wait();});
+
+        for(size_t k = 0; k < n; k++)
+        {
+            const auto& a = order[first + k];
+            auto&& [p, low_level_nexpansions] = results[k].get();
+            nexpansions += low_level_nexpansions;
+            nspeculated += 1;
+
+            // a path which avoids the earlier reservations avoids all but those committed since the snapshot was taken. No path under fewer
+            // reservations means no path under more of them
+            if(!p.empty())
+            {
+                const SegmentedPath speculated(p);
+                const bool is_conflicting = std::any_of(committed.begin(), committed.end(), [&speculated](const auto& q)
+                {
+                    IConflict* conflict = ConflictTable::EarliestBetween(0, 1, q, speculated);
+                    const bool is_conflict = conflict != nullptr;
+                    delete conflict;
+                    return is_conflict;
+                });
+
+                if(is_conflicting)
+                {
+                    nconflicting += 1;
+                    std::tie(p, low_level_nexpansions) = llp->Search(g, a, si);
+                    nexpansions += low_level_nexpansions;
+                }
+            }
+
+            if(!p.empty())
+            {
+                si.Add(p);
+                committed.emplace_back(p);
+                log.push_back(a.index);
+                planned_paths[a.index] = std::move(p);
+                to_replan.erase(a.index);
+            }
+        }
+    }
+
+    return to_replan;
+}
+
 AgentsIndicesSet PP::BlockingAgents(const Agents& all, const AgentsIndicesSet& blocked, const Paths& ongoing_plans)
 {
     AgentsIndicesSet blocking;
-    AgentsIndicesSet unaffeceted = Unaffected(ongoing_plans);
+
+    IndexUnaffected(all, ongoing_plans);
 
     for(const auto i: blocked)
     {
         const auto& a = all[i];
 
-        assert(unaffeceted.find(i) == unaffeceted.end());
+        assert(ongoing_plans[i].empty());
 
-        auto iter = unaffeceted.begin();
-        while(iter != unaffeceted.end())
+        // agent a is "run over" at its starting location
+        const auto iter = occupants.find(a.start);
+        if(iter != occupants.end())
         {
-            const auto j = *iter;
-            const auto& b = all[j];
-            const auto& p = ongoing_plans[j];
-            const auto h_val = (*ih)(a.start, b.goal) + (*ih)(b.goal, a.goal);
-            
-            // agent a is blocked by agent b whose "sitting on" its goal. i.e, the minimum-cost path a.start->b.goal->a.goal is blocked.
-            // agent a is "run over" at its starting location
-            if(h_val < INF || std::any_of(p.begin(), p.end(), [&a](const auto& c){return c == a.start;}))
+            blocking.insert(iter->second.begin(), iter->second.end());
+        }
+
+        // agent a is blocked by agent b whose "sitting on" its goal. i.e, the minimum-cost path a.start->b.goal->a.goal is blocked.
+        // each goal cell is checked once for all the agents sitting on it, and is dropped once they are blocking
+        auto goal = goals.begin();
+        while(goal != goals.end())
+        {
+            const auto& [c, sitting] = *goal;
+            if((*ih)(a.start, c) + (*ih)(c, a.goal) < INF)
             {
-                blocking.insert(j);
-                iter = unaffeceted.erase(iter);
+                blocking.insert(sitting.begin(), sitting.end());
+                goal = goals.erase(goal);
             }
             else
             {
-                iter++;
+                ++goal;
             }
         }
     }
@@ -128,6 +387,28 @@ AgentsIndicesSet PP::BlockingAgents(const Agents& all, const AgentsIndicesSet& b
     return blocking;
 }
 
+void PP::IndexUnaffected(const Agents& all, const Paths& planned_paths)
+{
+    occupants.clear();
+    goals.clear();
+
+    for(int i = 0; i < (int)planned_paths.size(); i++)
+    {
+        if(planned_paths[i].empty())
+            continue;
+
+        goals[all[i].goal].push_back(i);
+        for(const auto& c: planned_paths[i])
+        {
+            auto& v = occupants[c];
+            if(v.empty() || v.back() != i) // waits occupy the same cell consecutively
+            {
+                v.push_back(i);
+            }
+        }
+    }
+}
+
 AgentsIndicesSet PP::Unaffected(const Paths& planned_paths)
 {
     AgentsIndicesSet unaffeceted;
@@ -155,4 +436,22 @@ Agents PP::Shuffle(const Agents& all, const AgentsIndicesSet& group)
     std::shuffle(shuffled.begin(), shuffled.end(), gen);
     
     return shuffled;
+}
+
+std::string PP::GetStats(void) const
+{
+    std::stringstream ss;
+
+    for(int r = 0; r < (int)restart_stats.size() && pool; r++)
+    {
+        const auto& s = restart_stats[r];
+        ss << "#Restart " << r << ": started: " << s.nstarted << ", completed: " << s.ncompleted << ", won: " << s.nwon << ", cancelled: " << s.ncancelled << ", #expansions: " << s.nexpansions << ", runtime: " << s.runtime << '\n';
+    }
+
+    if(speculation_pool)
+    {
+        ss << "#Speculative low-level searches: " << nspeculated << ", #planned once again: " << nconflicting << '\n';
+    }
+
+    return ss.str() + (llp ? llp->GetStats() : "");
 }
\ No newline at end of file
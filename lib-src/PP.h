@@ -5,23 +5,33 @@
 #include "Graph.h"
 #include "IHighLevelPlanner.h"
 #include "InformedHeuristic.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <memory>
 #include <random>
+#include <vector>
 
 class ILowLevelPlanner;
 class IPolicy;
 
+// Prioritized planning. Agents are planned one after the other in a random order, each against the paths of the agents planned before it.
+// nshuffles independent restarts, each drawing its order from a generator of its own, run concurrently on forks of this planner. The first complete
+// plan cancels the other restarts, and the cheapest plan completed by then is kept. A single shuffle runs sequentially on this planner.
+// With a window of M > 1 agents, the next M agents in the order are planned concurrently against the same reservations, then committed in order.
+// An agent whose speculative path conflicts with a path committed before it in the window is planned once again.
 class PP: public IHighLevelPlanner
 {
 public:
     PP() = default; 
-    PP(ILowLevelPlanner* llp, int nshuffles=20);
-    virtual ~PP() {delete llp; llp = nullptr;};
+    PP(ILowLevelPlanner* llp, int nshuffles=20, int window=1);
+    virtual ~PP() {pool.reset(); speculation_pool.reset(); delete llp; llp = nullptr;};
 
     PlanResult Plan(const Graph& g, const Agents& as, float timeout) override;
     std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) override;
     
-    inline void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override {this->ih = &ih; llp->Init(policy, ih);}
-    inline std::string GetName(void) const override {return "PP+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    inline std::string GetName(void) const override {return (window > 1 ? "Speculative-PP(" + std::to_string(window) + ")+" : "PP+") + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    std::string GetStats(void) const override;
 
 protected:
     ILowLevelPlanner* llp;
@@ -30,9 +40,33 @@ protected:
     std::mt19937 gen;
     const InformedHeuristic* ih;
     unsigned long nexpansions;
+
+    struct RestartStats
+    {
+        unsigned long nstarted = 0, ncompleted = 0, nwon = 0, ncancelled = 0, nexpansions = 0;
+        double runtime = 0;
+    };
+
+    std::vector<std::unique_ptr<PP>> forks; // forks[i] := planner of the restarts run by worker i
+    std::unique_ptr<WorkStealingPool> pool;
+    std::vector<RestartStats> restart_stats; // restart_stats[r] := statistics of the r-th restart of each call, over all calls
+    std::atomic<bool> is_done = false; // cancellation flag of the forks, raised once a restart completed a plan or this planner is cancelled
+
+    int window; // number of agents planned speculatively at once, restarts are not speculative
+    std::vector<std::unique_ptr<ILowLevelPlanner>> planners; // planners[i] := low-level planner of speculation worker i
+    std::unique_ptr<WorkStealingPool> speculation_pool;
+    unsigned long nspeculated = 0, nconflicting = 0; // speculative searches, and those whose path had to be planned once again
+
+    // indexes of the agents which keep their paths, rebuilt by BlockingAgents
+    CoordinateMap occupants; // cell -> agents whose path occupies it
+    CoordinateMap goals; // goal cell -> agents whose goal it is
     
+    bool Solve(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, float timeout);
+    std::tuple<bool, unsigned long> Race(const Graph& g, const Agents& all, Paths& planned_paths, const AgentsIndicesSet& affected, float timeout);
     AgentsIndicesSet ReplanGroup(const Graph& g, const Agents& all, Paths& planned_paths, AgentsIndicesSet group);
+    AgentsIndicesSet ReplanGroupSpeculatively(const Graph& g, const Agents& all, Paths& planned_paths, AgentsIndicesSet group);
     Agents Shuffle(const Agents& all, const AgentsIndicesSet& affected);
     AgentsIndicesSet BlockingAgents(const Agents& all, const AgentsIndicesSet& blocked, const Paths& ongoing_plans);
+    void IndexUnaffected(const Agents& all, const Paths& planned_paths);
     AgentsIndicesSet Unaffected(const Paths& planned_paths);
 };
\ No newline at end of file
@@ -0,0 +1,201 @@
+#include "ParallelCBS.h"
+#include "IConflict.h"
+#include "ILowLevelPlanner.h"
+#include "Timer.h"
+#include <ctime>
+#include <sstream>
+
+// CPU time of the calling thread, in seconds. Unlike wall time it excludes the time a thread waits for a core
+static double ThreadTime(void)
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+ParallelCBS::ParallelCBS(ILowLevelPlanner* llp, const int nthreads, const Heuristic heuristic): CBS(llp, heuristic), nthreads(std::max(nthreads, 1)), window(2 * this->nthreads){}
+
+ParallelCBS::~ParallelCBS()
+{
+    pool.reset(); // workers must stop before their planners are freed
+}
+
+void ParallelCBS::Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k)
+{
+    CBS::Init(policy, ih, k);
+
+    pool.reset();
+    planners.clear();
+    for(int i = 1; i < nthreads; i++)
+    {
+        planners.emplace_back(llp->Clone());
+        planners.back()->Init(policy, ih);
+        cats[planners.back().get()] = std::make_unique<ConflictAvoidanceTable>();
+    }
+
+    if(!planners.empty())
+    {
+        pool = std::make_unique<WorkStealingPool>(planners.size());
+    }
+}
+
+std::tuple<bool, Paths, Constraints> ParallelCBS::Search(const Graph& g, const Agents& as, const float timeout)
+{
+    CTNode goal;
+    MinFibHeap open;
+    Jobs jobs;
+    Timer timer;
+    bool is_plan_found = false;
+    llp->Invalidate();
+    for(auto& planner: planners)
+    {
+        planner->Invalidate();
+    }
+    mdds.clear();
+    pair_weights.clear();
+    auto root = CBS::Init(g, as);
+    if(root)
+    {
+        open.push(root);
+    }
+
+    timer.Start(timeout);
+
+    while(!open.empty() && !timer.ExceedsRuntime() && !IsCancelled() && !is_plan_found)
+    {
+        auto n = open.top();
+        open.pop();
+
+        is_plan_found = n.conflicts.IsEmpty();
+        if(is_plan_found)
+        {
+            goal = std::forward<CTNode>(n);
+        }
+        else
+        {
+            Dispatch(jobs, open, g, as); // workers speculate on the nodes below n, while n is expanded
+            Commit(n, Take(jobs, n, g, as), open);
+        }
+    }
+
+    Drain(jobs);
+    wall_time += timer.GetRuntime();
+    lookup.clear();
+
+    return {is_plan_found && !timer.ExceedsRuntime(), Materialize(goal.paths), Collect(goal.constraints)};
+}
+
+ParallelCBS::Expansion ParallelCBS::Speculate(const CTNode& n, const Graph& g, const Agents& as, ILowLevelPlanner* planner)
+{
+    const double start = ThreadTime();
+    Expansion e;
+
+    auto [c, cardinality] = ChooseConflict(n, g, as);
+    e.conflict.reset(c);
+    e.cardinality = cardinality;
+
+    // unlike CBS::Expand, duplicates are not known yet. They are generated anyway and discarded by Commit
+    for(const auto& new_constraint: c->Resolve())
+    {
+        auto successor = Generate(g, as[new_constraint.constrained_agent], n, new_constraint, planner);
+        if(successor)
+        {
+            successor.h = HeuristicOf(successor, g, as, planner);
+        }
+        e.successors.emplace_back(new_constraint, std::move(successor));
+    }
+
+    std::lock_guard lock(busy_time_mutex);
+    busy_time += ThreadTime() - start;
+    return e;
+}
+
+void ParallelCBS::Dispatch(Jobs& jobs, const MinFibHeap& open, const Graph& g, const Agents& as)
+{
+    if(!pool)
+        return;
+
+    size_t i = 0;
+    for(auto iter = open.ordered_begin(); iter != open.ordered_end() && i < window; ++iter, i++)
+    {
+        if(jobs.contains(iter->hash) || iter->conflicts.IsEmpty())
+            continue;
+
+        auto job = std::make_shared<Job>();
+        job->n = *iter;
+        jobs[iter->hash] = job;
+        nspeculated += 1;
+
+        // a job is claimed exactly once. An unclaimed job left in the pool after the search touches nothing but itself
+        pool->Submit([this, job, &g, &as](const int worker_index)
+        {
+            if(!job->is_claimed.exchange(true))
+                job->promise.set_value(Speculate(job->n, g, as, planners[worker_index].get()));
+        });
+    }
+}
+
+ParallelCBS::Expansion ParallelCBS::Take(Jobs& jobs, const CTNode& n, const Graph& g, const Agents& as)
+{
+    const auto iter = jobs.find(n.hash);
+    if(iter == jobs.end())
+    {
+        return Speculate(n, g, as, llp);
+    }
+
+    auto job = iter->second;
+    jobs.erase(iter);
+
+    if(!job->is_claimed.exchange(true)) // no worker took the job yet
+    {
+        nspeculated -= 1;
+        return Speculate(n, g, as, llp);
+    }
+
+    return job->promise.get_future().get();
+}
+
+void ParallelCBS::Commit(const CTNode& n, Expansion&& e, MinFibHeap& open)
+{
+    // same as CBS::Expand, in the same order
+    nsplit[(int)e.cardinality] += 1;
+
+    for(auto& [new_constraint, successor]: e.successors)
+    {
+        const auto successor_hash = n.hash ^ Constraint::Hasher{}(new_constraint);
+
+        if(!lookup.contains(successor_hash))
+        {
+            high_level_nexpansions += 1;
+
+            if(successor)
+            {
+                lookup.insert(successor.hash);
+                open.push(std::move(successor));
+            }
+        }
+    }
+}
+
+void ParallelCBS::Drain(Jobs& jobs)
+{
+    // unclaimed jobs are cancelled, running ones are awaited since they refer to the graph and agents of the search
+    for(auto& [hash, job]: jobs)
+    {
+        if(job->is_claimed.exchange(true))
+            job->promise.get_future().wait();
+    }
+
+    ndiscarded += jobs.size();
+    jobs.clear();
+}
+
+std::string ParallelCBS::GetStats(void) const
+{
+    std::stringstream ss;
+    ss << "#Speculative CT node expansions: " << nspeculated << '\n';
+    ss << "#Discarded speculative expansions: " << ndiscarded << '\n';
+    ss << "#Stolen expansions: " << (pool ? pool->GetNumberOfSteals() : 0) << '\n';
+    ss << "Parallel utilization with " << nthreads << " threads: " << (wall_time > 0 ? busy_time / wall_time : 1) << '\n'; // average number of busy threads, the speedup over sequential CBS is not measured
+    return ss.str() + CBS::GetStats();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CBS.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// CBS which expands CT nodes concurrently. The main thread pops nodes in the same order as CBS does, while the nodes right below the top of open
+// are expanded speculatively by worker threads, each with a low-level planner of its own. Speculation is bounded to a window of nodes below the top.
+// A node which no worker took yet is expanded by the main thread. For a deterministic low-level planner the expanded nodes and the solution are
+// the same as those of CBS.
+class ParallelCBS: public CBS
+{
+public:
+    ParallelCBS(ILowLevelPlanner* llp, int nthreads, Heuristic heuristic=Heuristic::None);
+    virtual ~ParallelCBS();
+
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    inline std::string GetName(void) const override {return "Parallel-CBS(" + std::to_string(nthreads) + ")" + GetHeuristicName() + "+" + (llp ? llp->GetName() : "NO-LOW-LEVEL-PLANNER");}
+    std::string GetStats(void) const override;
+
+protected:
+    struct Expansion
+    {
+        std::unique_ptr<IConflict> conflict;
+        Cardinality cardinality = Cardinality::Unclassified;
+        std::vector<std::tuple<Constraint, CTNode>> successors; // ordered as conflict->Resolve(), a successor is empty if no path satisfies its constraint
+    };
+
+    struct Job
+    {
+        CTNode n;
+        std::atomic<bool> is_claimed = false; // set by the thread which expands n, either a worker or the main thread
+        std::promise<Expansion> promise;
+    };
+
+    using Jobs = boost::unordered_map<size_t, std::shared_ptr<Job>>; // CTNode::hash -> speculative expansion of the node
+
+    int nthreads; // including the main thread
+    size_t window; // number of nodes below the top of open which may be expanded speculatively
+    std::vector<std::unique_ptr<ILowLevelPlanner>> planners; // planners[i] := low-level planner of worker i
+    std::unique_ptr<WorkStealingPool> pool;
+    unsigned long nspeculated = 0, ndiscarded = 0;
+    double busy_time = 0; // CPU seconds spent expanding CT nodes, summed over all threads
+    double wall_time = 0; // seconds spent searching
+    std::mutex busy_time_mutex;
+
+    std::tuple<bool, Paths, Constraints> Search(const Graph& g, const Agents& as, float timeout) override;
+    Expansion Speculate(const CTNode& n, const Graph& g, const Agents& as, ILowLevelPlanner* planner);
+    void Dispatch(Jobs& jobs, const MinFibHeap& open, const Graph& g, const Agents& as);
+    Expansion Take(Jobs& jobs, const CTNode& n, const Graph& g, const Agents& as);
+    void Commit(const CTNode& n, Expansion&& e, MinFibHeap& open);
+    void Drain(Jobs& jobs);
+};
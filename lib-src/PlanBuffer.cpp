@@ -0,0 +1,65 @@
+#include "PlanBuffer.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+PlanBuffer::PlanBuffer(Paths&& plans): plans(std::move(plans)), cursors(this->plans.size(), 0){}
+
+void PlanBuffer::Swap(Paths&& other)
+{
+    plans = std::move(other);
+    cursors.assign(plans.size(), 0);
+}
+
+void PlanBuffer::Swap(const int agent_index, Path&& p)
+{
+    plans[agent_index] = std::move(p);
+    cursors[agent_index] = 0;
+}
+
+void PlanBuffer::Step(void)
+{
+    const int k = plans.size();
+
+    for(int i = 0; i < k; i++)
+    {
+        if(cursors[i] + 1 < (int)plans[i].size())
+            cursors[i] += 1;
+    }
+}
+
+const Coordinate& PlanBuffer::CurrentOf(const int agent_index) const
+{
+    const auto& p = plans[agent_index];
+    assert(!p.empty());
+    return p[cursors[agent_index]];
+}
+
+Paths PlanBuffer::Remaining(void) const
+{
+    Paths remaining;
+    const int k = plans.size();
+    remaining.reserve(k);
+
+    for(int i = 0; i < k; i++)
+    {
+        const auto& p = plans[i];
+        remaining.emplace_back(p.empty() ? p.begin() : std::next(p.begin(), cursors[i]), p.end());
+    }
+
+    return remaining;
+}
+
+PathViews PlanBuffer::RemainingViews(void) const
+{
+    PathViews remaining;
+    const int k = plans.size();
+    remaining.reserve(k);
+
+    for(int i = 0; i < k; i++)
+    {
+        remaining.emplace_back(PathView(plans[i]).subspan(plans[i].empty() ? 0 : cursors[i]));
+    }
+
+    return remaining;
+}
\ No newline at end of file
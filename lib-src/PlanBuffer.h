@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Coordinate.h"
+#include "Types.h"
+#include <vector>
+
+// Ongoing plans of all agents, executed through a cursor per agent rather than by erasing the executed prefix of each plan.
+// Plans are never modified in place: replanning swaps the plan of an agent, which restarts its cursor.
+class PlanBuffer
+{
+public:
+    PlanBuffer() = default;
+    PlanBuffer(Paths&& plans);
+
+    void Swap(Paths&& plans); // each plan starts at the current coordinate of its agent
+    void Swap(int agent_index, Path&& p);
+    void Step(void); // advance all agents by a single timestep
+    const Coordinate& CurrentOf(int agent_index) const; // agent waits at its goal once its plan is done
+    Paths Remaining(void) const; // unexecuted suffix of each plan, starting at the current coordinate of its agent
+    PathViews RemainingViews(void) const; // as Remaining, without copying; invalidated by Swap
+    inline size_t Size(void) const {return plans.size();}
+
+private:
+    Paths plans;
+    std::vector<int> cursors;
+};
\ No newline at end of file
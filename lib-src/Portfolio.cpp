@@ -0,0 +1,172 @@
+#include "Portfolio.h"
+#include "Timer.h"
+#include "Utils.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+
+Portfolio::Portfolio(const std::vector<IHighLevelPlanner*>& members, const float grace): grace(grace)
+{
+    for(auto* member: members)
+    {
+        this->members.emplace_back(member);
+        member->SetCancellationFlag(&is_stopped);
+    }
+}
+
+Portfolio::~Portfolio()
+{
+    pool.reset(); // workers must stop before the members are freed
+}
+
+void Portfolio::Init(IPolicy* policy, const InformedHeuristic& ih, const size_t k)
+{
+    for(auto& member: members)
+    {
+        member->Init(policy, ih, k);
+    }
+
+    stats.assign(members.size(), {});
+    last_winner = -1;
+    pool = std::make_unique<WorkStealingPool>(members.size());
+}
+
+PlanResult Portfolio::Plan(const Graph& g, const Agents& as, const float timeout)
+{
+    Timer timer;
+    timer.Start(timeout);
+
+    auto [winner, o, nexpansions] = Race([&g, &as, timeout](IHighLevelPlanner* member)
+    {
+        Outcome o;
+        std::tie(o.is_plan_found, o.paths, o.nexpansions, o.runtime) = member->Plan(g, as, timeout);
+        return o;
+    }, timeout);
+
+    return {winner != -1, std::move(o.paths), nexpansions, timer.Stop()};
+}
+
+std::tuple<bool, unsigned long> Portfolio::Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, const float timeout, const int current_timestep)
+{
+    // each member replans a copy of the ongoing plans, which is left untouched until all members are done
+    auto [winner, o, nexpansions] = Race([&g, &all, &ongoing_plans, &affected, timeout, current_timestep](IHighLevelPlanner* member)
+    {
+        Timer timer;
+        Outcome o;
+
+        timer.Start();
+        o.paths = ongoing_plans;
+        std::tie(o.is_plan_found, o.nexpansions) = member->Replan(g, all, o.paths, affected, timeout, current_timestep);
+        o.runtime = timer.Stop();
+
+        return o;
+    }, timeout);
+
+    if(winner != -1)
+    {
+        ongoing_plans = std::move(o.paths);
+    }
+
+    return {winner != -1, nexpansions};
+}
+
+std::tuple<int, Portfolio::Outcome, unsigned long> Portfolio::Race(const Run& run, const float timeout)
+{
+    const int n = members.size();
+    std::mutex m;
+    std::condition_variable cv;
+    std::vector<Outcome> outcomes(n);
+    int ndone = 0;
+    bool is_plan_found = false;
+
+    is_stopped = false;
+
+    for(int i = 0; i < n; i++)
+    {
+        pool->Submit([this, i, &run, &m, &cv, &outcomes, &ndone, &is_plan_found](const int /*worker_index*/)
+        {
+            auto o = run(members[i].get());
+            o.is_cancelled = !o.is_plan_found && is_stopped;
+
+            std::lock_guard<std::mutex> lock(m);
+            is_plan_found = is_plan_found || o.is_plan_found;
+            outcomes[i] = std::move(o);
+            ndone += 1;
+            cv.notify_all();
+        });
+    }
+
+    {
+        // the members are cancelled once the timeout passes with no plan, or the grace period after the first plan. The outcomes are
+        // written through references to this frame, hence all members are awaited before returning
+        std::unique_lock<std::mutex> lock(m);
+        if(cv.wait_for(lock, std::chrono::duration<float>(timeout), [&]{return ndone == n || is_plan_found;}))
+        {
+            cv.wait_for(lock, std::chrono::duration<float>(grace), [&]{return ndone == n;});
+        }
+        is_stopped = true;
+        cv.wait(lock, [&]{return ndone == n;});
+    }
+
+    int winner = -1;
+    long best_cost = 0;
+    unsigned long nexpansions = 0;
+
+    for(int i = 0; i < n; i++)
+    {
+        const auto& o = outcomes[i];
+        auto& s = stats[i];
+
+        s.nsucceeded += o.is_plan_found;
+        s.ncancelled += o.is_cancelled;
+        s.runtime += o.runtime;
+        nexpansions += o.nexpansions;
+
+        if(o.is_plan_found)
+        {
+            const long cost = ObjectiveFunction::SumOfCost(o.paths);
+            if(winner == -1 || cost < best_cost)
+            {
+                winner = i;
+                best_cost = cost;
+            }
+        }
+    }
+
+    if(winner == -1)
+    {
+        return {winner, Outcome{}, nexpansions};
+    }
+
+    stats[winner].nwins += 1;
+    last_winner = winner;
+
+    return {winner, std::move(outcomes[winner]), nexpansions};
+}
+
+std::string Portfolio::GetName(void) const
+{
+    std::string name = "Portfolio(";
+
+    for(size_t i = 0; i < members.size(); i++)
+    {
+        name += (i > 0 ? ", " : "") + members[i]->GetName();
+    }
+
+    return name + ")";
+}
+
+std::string Portfolio::GetStats(void) const
+{
+    std::stringstream ss;
+
+    for(size_t i = 0; i < members.size(); i++)
+    {
+        const auto& s = stats[i];
+        ss << "#Portfolio member " << members[i]->GetName() << ": wins: " << s.nwins << ", succeeded: " << s.nsucceeded << ", cancelled: " << s.ncancelled << ", runtime: " << s.runtime << '\n';
+    }
+    ss << "Last winner: " << (last_winner != -1 ? members[last_winner]->GetName() : "none") << '\n';
+
+    return ss.str();
+}
\ No newline at end of file
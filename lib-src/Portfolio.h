@@ -0,0 +1,52 @@
+#pragma once
+
+#include "IHighLevelPlanner.h"
+#include "Types.h"
+#include "WorkStealingPool.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Runs several high-level planners concurrently on the same graph, each with a low-level planner of its own. Once a member finds a plan, the others
+// are given a grace period to find a cheaper one, then the cheapest plan found by then is taken and the remaining members are cancelled.
+// The wins of each member are counted, to tune the members per map family.
+class Portfolio: public IHighLevelPlanner
+{
+public:
+    Portfolio(const std::vector<IHighLevelPlanner*>& members, float grace=0.1); // takes ownership of the members
+    virtual ~Portfolio();
+
+    PlanResult Plan(const Graph& g, const Agents& as, float timeout) override;
+    std::tuple<bool, unsigned long> Replan(const Graph& g, const Agents& all, Paths& ongoing_plans, const AgentsIndicesSet& affected, float timeout, int current_timestep) override;
+
+    void Init(IPolicy* policy, const InformedHeuristic& ih, size_t k) override;
+    std::string GetName(void) const override;
+    std::string GetStats(void) const override;
+
+protected:
+    struct Outcome
+    {
+        bool is_plan_found = false, is_cancelled = false;
+        Paths paths;
+        unsigned long nexpansions = 0;
+        double runtime = 0;
+    };
+
+    struct MemberStats
+    {
+        unsigned long nwins = 0, nsucceeded = 0, ncancelled = 0;
+        double runtime = 0;
+    };
+
+    using Run = std::function<Outcome(IHighLevelPlanner* member)>;
+
+    std::vector<std::unique_ptr<IHighLevelPlanner>> members;
+    float grace; // seconds
+    std::unique_ptr<WorkStealingPool> pool;
+    std::atomic<bool> is_stopped = false; // cancellation flag of the members
+    std::vector<MemberStats> stats;
+    int last_winner = -1;
+
+    std::tuple<int, Outcome, unsigned long> Race(const Run& run, float timeout); // winner, its outcome and the expansions of all members
+};
\ No newline at end of file
@@ -0,0 +1,20 @@
+#include "RectangleConflict.h"
+#include <cassert>
+#include <sstream>
+
+RectangleConflict::RectangleConflict(const std::vector<int>& agents_indices, const int timestep, const std::array<Coordinate, 2>& firsts, const std::array<Coordinate, 2>& lasts, const std::array<int, 2>& timesteps):
+IConflict(agents_indices, timestep), firsts(firsts), lasts(lasts), timesteps(timesteps){}
+
+std::string RectangleConflict::ToString(void) const
+{
+    std::stringstream ss;
+    ss << "Rectangle-Conflict at: " << timestep << ". Agent" << agents_indices[0] << " barred along " << firsts[0] << " - " << lasts[0]
+       << ", Agent" << agents_indices[1] << " along " << firsts[1] << " - " << lasts[1] << '.';
+    return ss.str();
+}
+
+std::vector<Constraint> RectangleConflict::Resolve(void) const
+{
+    assert(agents_indices.size() == 2);
+    return {Constraint::Barrier(agents_indices[0], agents_indices[1], firsts[0], lasts[0], timesteps[0]), Constraint::Barrier(agents_indices[1], agents_indices[0], firsts[1], lasts[1], timesteps[1])};
+}
\ No newline at end of file
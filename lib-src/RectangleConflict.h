@@ -0,0 +1,19 @@
+#pragma once
+
+#include "IConflict.h"
+#include "Coordinate.h"
+#include <array>
+
+// Agents which cross a rectangle along shortest paths, one from side to side and the other from bottom to top, collide wherever they cross.
+// Each agent is given a barrier along the side of the rectangle it leaves through, timed as if it were reached along a shortest path
+struct RectangleConflict: public IConflict
+{
+    const std::array<Coordinate, 2> firsts, lasts; // barrier of agents_indices[k] spans firsts[k] to lasts[k]
+    const std::array<int, 2> timesteps; // timestep of firsts[k]
+
+    RectangleConflict(const std::vector<int>& agents_indices, int timestep, const std::array<Coordinate, 2>& firsts, const std::array<Coordinate, 2>& lasts, const std::array<int, 2>& timesteps);
+    virtual ~RectangleConflict() = default;
+
+    std::string ToString(void) const override;
+    std::vector<Constraint> Resolve(void) const override;
+};
\ No newline at end of file
@@ -39,7 +39,7 @@ SEES_SIPP::SEES_SIPP(const float w, const HeuristicFunction& h): w(w), nexpansio
 
 Path SEES_SIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
 {
-    auto root = Init(a, si);
+    auto root = Init(g, a, si);
     Vertex* goal = nullptr;
 
     float threshold_f = (root != nullptr ? root->h : INF);
@@ -50,9 +50,8 @@ Path SEES_SIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
         std::tie(threshold_f, threshold_f_hat, goal) = Speedy(root, g, a, si, threshold_f, threshold_f_hat);
     }
 
-    auto path = goal != nullptr ? ReconstructPath(goal) : Path{};
-    Clear();
-    return path;
+    lower_bound = goal != nullptr ? root->h : INF;
+    return goal != nullptr ? ReconstructPath(goal) : Path{};
 }
 
 std::tuple<float, float, SEES_SIPP::Vertex*> SEES_SIPP::Speedy(Vertex* root, const Graph& g, const Agent& a, SafeIntervals& si, const float threshold_f, const float threshold_f_hat)
@@ -118,19 +117,19 @@ std::tuple<Path, unsigned long> SEES_SIPP::Search(const Graph& g, const Agent& a
     return {Plan(g, a, si), nexpansions};
 }
 
-SEES_SIPP::Vertex* SEES_SIPP::Init(const Agent& a, SafeIntervals& si)
+SEES_SIPP::Vertex* SEES_SIPP::Init(const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Vertex* start = nullptr;
     const auto first_safe_interval = *si.IntervalsOf(a.start).begin();
+    table.Reset(g.GetNumberOfIndices());
 
     if(first_safe_interval.IsIntersects(0) && !first_safe_interval.IsEmpty())
     {
-        start = new Vertex();
+        start = table.Create(g.IndexOf(a.start), 0);
         start->s = {a.start, first_safe_interval};
         start->g = 0;
         start->h = ih ? std::max((*ih)(a.start, a.goal), si.IntervalsOf(a.goal).rbegin()->start) : h(a.start, a.goal);
         start->h_hat = w * start->h;
-        table[start->s] = start;
     }
     
     return start;
@@ -139,6 +138,8 @@ SEES_SIPP::Vertex* SEES_SIPP::Init(const Agent& a, SafeIntervals& si)
 SEES_SIPP::Successors SEES_SIPP::Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Successors successors;
+    const int successor_index = g.IndexOf(successor_coordinate);
+    int ordinal = 0;
 
     for(const auto& successor_safe_interval: si.IntervalsOf(successor_coordinate))
     {
@@ -147,22 +148,19 @@ SEES_SIPP::Successors SEES_SIPP::Generate(Vertex* parent, const Coordinate& succ
 
         if(IsTransitionAllowed(parent, successor_state, successor_arriving_time))
         {
-            Vertex* successor;
-            if(IsGenerated(successor_state))
-            {
-                successor = table.at(successor_state);
-            }
-            else
+            Vertex* successor = table.Find(successor_index, ordinal);
+            if(!successor)
             {
-                successor = new Vertex();
+                successor = table.Create(successor_index, ordinal);
                 successor->s = successor_state;
                 successor->h = ih ? std::max((*ih)(successor->s.c, a.goal), si.IntervalsOf(a.goal).rbegin()->start - successor_arriving_time) : h(successor->s.c, a.goal);
                 successor->h_hat = w * successor->h;
-                table[successor->s] = successor;
             }
 
             successors.push_back(successor);
         }
+
+        ordinal += 1;
     }
     
     return successors;
@@ -187,22 +185,9 @@ float SEES_SIPP::EarliestArrivingTime(const Vertex* parent, const State& success
     return std::max(successor_state.i.start, successor_arriving_time);
 }
 
-void SEES_SIPP::Clear(void)
-{
-    for(auto& [state, vertex]: table)
-        delete(vertex);
-
-    table.clear();
-}
-
-bool SEES_SIPP::IsGenerated(const State& s) const
-{
-    return table.find(s) != table.end();
-}
-
 bool SEES_SIPP::IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const
 {
-    return successor_state.i.IsIntersects(arriving_time) && arriving_time <= parent->s.i.end;
+    return parent->s.c != successor_state.c && successor_state.i.IsIntersects(arriving_time) && arriving_time <= parent->s.i.end;
 }
 
 bool SEES_SIPP::IsGoal(const Vertex* v, const Agent& a) const
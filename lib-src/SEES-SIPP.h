@@ -7,6 +7,7 @@
 #include "State.h"
 #include "ILowLevelPlanner.h"
 #include "SafeIntervals.h"
+#include "StateTable.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include <boost/unordered_map.hpp>
 #include <vector>
@@ -21,6 +22,8 @@ public:
     std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si) override;
     inline void Init(IPolicy* policy, const InformedHeuristic& ih) override{this->policy = policy; this->ih = &ih; nexpansions = 0;}
     inline std::string GetName(void) const override {return "SEES-SIPP";}
+    inline ILowLevelPlanner* Clone(void) const override {return new SEES_SIPP(w, h);}
+    inline float GetLowerBound(void) const override {return lower_bound;}
 
 protected:
     struct Vertex;
@@ -30,7 +33,7 @@ protected:
 
     using MinFibHeap = boost::heap::fibonacci_heap<Vertex*, boost::heap::compare<VertexComparator>>;
     using Successors = std::vector<Vertex*>;
-    using LookupTable = boost::unordered::unordered_map<State, Vertex*, State::Hasher, State::Equal>;
+    using LookupTable = StateTable<Vertex>;
     using VerticesSet = boost::unordered::unordered_set<Vertex*, VertexHasher, VertexEqual>;
     
     struct Vertex
@@ -52,18 +55,17 @@ protected:
 
     float w;
     unsigned long nexpansions;
+    float lower_bound = INF; // heuristic value of the start, thresholds of the speedy iterations do not bound the optimal cost
     const HeuristicFunction& h;
     LookupTable table;
     const IPolicy* policy;
     const InformedHeuristic* ih;
     
     std::tuple<float, float, Vertex*> Speedy(Vertex* root, const Graph& g, const Agent& a, SafeIntervals& si, const float threshold_f, const float threshold_f_hat);
-    Vertex* Init(const Agent& a, SafeIntervals& si);
+    Vertex* Init(const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Expand(Vertex* current, const Graph& g, const Agent& a, SafeIntervals& si);
     float EarliestArrivingTime(const Vertex* parent, const State& successor_state, const Graph& g) const;
-    void Clear(void);
-    bool IsGenerated(const State& s) const;
     bool IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time) const;
     bool IsGoal(const Vertex* v, const Agent& a) const;
     int WaitingTimeAtParent(const Vertex* parent, const Vertex* successor) const;
@@ -1,4 +1,5 @@
 #include "SIPP.h"
+#include "ConflictAvoidanceTable.h"
 #include "SafeIntervals.h"
 #include "State.h"
 #include "Printer.h"
@@ -17,6 +18,8 @@ bool SIPP::Vertex::operator < (const Vertex& other) const noexcept
 {
     if(fVal() == other.fVal())
     {
+        if(nconflicts != other.nconflicts)
+            return nconflicts < other.nconflicts; // prefer node with fewer soft collisions
         if(h == other.h)
             return g > other.h;  // break tie in a depth-first manner: prefer node further from root
         return h < other.h;// prefer node with LOWER h cost: closer to destination
@@ -31,13 +34,23 @@ bool SIPP::Vertex::operator == (const Vertex& other) const noexcept
 
 Path SIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
 {
-    auto root = Init(a, si);
+    auto root = Init(g, a, si);
     nexpansions = 0;
     MinFibHeap open;
-    Vertex* current;
-    bool is_goal_found = false;
     if(root)
+    {
         root->handler = open.push(root);
+        root->in_open = true;
+    }
+
+    const Vertex* goal = BestFirstSearch(open, g, a, si);
+    return goal ? ReconstructPath(goal) : Path{};
+}
+
+SIPP::Vertex* SIPP::BestFirstSearch(MinFibHeap& open, const Graph& g, const Agent& a, SafeIntervals& si)
+{
+    Vertex* current;
+    bool is_goal_found = false;
 
     while(!open.empty() && !is_goal_found)
     {
@@ -45,7 +58,7 @@ Path SIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
         open.pop();
         current->in_open = false;
 
-        is_goal_found = (current->s.c == a.goal && current->s.i.IsUnbounded());
+        is_goal_found = IsGoal(current, a);
 
         if(!is_goal_found)
         {
@@ -53,9 +66,14 @@ Path SIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
             {
                 assert(successor != nullptr);
 
-                if(EarliestArrivingTime(current, successor->s, g) < successor->g) // a shorter path to successor is found
+                const float arriving_time = EarliestArrivingTime(current, successor->s, g);
+                const int nconflicts = cat ? current->nconflicts + CollisionsOf(current, successor, arriving_time, g, a) : 0;
+
+                // a shorter path to successor is found, or an equally short one with fewer soft collisions
+                if(arriving_time < successor->g || (arriving_time == successor->g && nconflicts < successor->nconflicts))
                 {
-                    successor->g = EarliestArrivingTime(current, successor->s, g);
+                    successor->g = arriving_time;
+                    successor->nconflicts = nconflicts;
                     successor->parent = current;
 
                     if(successor->in_open)
@@ -71,9 +89,7 @@ Path SIPP::Plan(const Graph& g, const Agent& a, SafeIntervals& si)
         }
     }
     
-    auto path = is_goal_found ? ReconstructPath(current) : Path{};
-    Clear();
-    return path;
+    return is_goal_found ? current : nullptr;
 }
 
 std::tuple<Path, unsigned long> SIPP::Search(const Graph& g, const Agent& a, SafeIntervals& si)
@@ -96,11 +112,6 @@ SIPP::Successors SIPP::Expand(Vertex* current, const Graph& g, const Agent& a, S
     return successors;
 }
 
-bool SIPP::IsGenerated(const State& s) const
-{
-    return table.find(s) != table.end();
-}
-
 float SIPP::EarliestArrivingTime(const Vertex* parent, const State& successor_state, const Graph& g)
 {
     assert(parent != nullptr);
@@ -120,6 +131,8 @@ bool SIPP::IsTransitionAllowed(const Vertex* parent, const State& successor_stat
 SIPP::Successors SIPP::Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Successors successors;
+    const int successor_index = g.IndexOf(successor_coordinate);
+    int ordinal = 0;
 
     for(const auto& successor_safe_interval: si.IntervalsOf(successor_coordinate))
     {
@@ -128,31 +141,31 @@ SIPP::Successors SIPP::Generate(Vertex* parent, const Coordinate& successor_coor
 
         if(IsTransitionAllowed(parent, successor_state, successor_arriving_time))
         {
-            Vertex* successor;
-            if(IsGenerated(successor_state))
-                successor = table.at(successor_state);
-            else
+            Vertex* successor = table.Find(successor_index, ordinal);
+            if(!successor)
             {
-                successor = new Vertex();
+                successor = table.Create(successor_index, ordinal);
                 successor->s = successor_state;
                 successor->h = ih ? std::max((*ih)(successor_coordinate, a.goal), si.IntervalsOf(a.goal).rbegin()->start - successor_arriving_time) : Heuristic::ManhattanDistance(successor_coordinate, a.goal);
-                table[successor->s] = successor;
             }
             successors.push_back(successor);
         }
+
+        ordinal += 1;
     }
     
     return successors;
 }
 
-SIPP::Vertex* SIPP::Init(const Agent& a, SafeIntervals& si)
+SIPP::Vertex* SIPP::Init(const Graph& g, const Agent& a, SafeIntervals& si)
 {
     Vertex* start = nullptr;
     const auto start_safe_interval = *si.IntervalsOf(a.start).begin();
+    table.Reset(g.GetNumberOfIndices());
 
     if(start_safe_interval.IsIntersects(0))// Expected starting state to be reachable at the beginning
     {
-        start = new Vertex();
+        start = table.Create(g.IndexOf(a.start), 0);
         start->parent = nullptr;
 
         start->s = State(a.start, start_safe_interval);
@@ -160,12 +173,27 @@ SIPP::Vertex* SIPP::Init(const Agent& a, SafeIntervals& si)
 
         start->g = 0;
         start->h = ih ? std::max((*ih)(a.start, a.goal), si.IntervalsOf(a.goal).rbegin()->start) : Heuristic::ManhattanDistance(a.start, a.goal);
-        table[start->s] = start;
     }
 
     return start;
 }
 
+bool SIPP::IsGoal(const Vertex* v, const Agent& a) const
+{
+    return v->s.c == a.goal && v->s.i.IsUnbounded();
+}
+
+int SIPP::CollisionsOf(const Vertex* parent, const Vertex* successor, const float arriving_time, const Graph& g, const Agent& a) const
+{
+    // waiting at the parent, traversing the edge and arriving at the successor. An agent stays at its goal once it is reached
+    const int arrival = arriving_time;
+    const int departure = arriving_time - g.WeightOf({parent->s.c, successor->s.c});
+
+    return cat->Count(parent->s.c, parent->g + 1, departure, a.index)
+        + cat->CountSwaps(parent->s.c, successor->s.c, arrival, a.index)
+        + cat->Count(successor->s.c, arrival, IsGoal(successor, a) ? INT_MAX : arrival, a.index);
+}
+
 int SIPP::WaitingTimeAtParent(const Vertex* parent, const Vertex* successor) const
 {
     assert(!parent || successor->g >= parent->g);
@@ -193,12 +221,4 @@ Path SIPP::ReconstructPath(const Vertex* goal) const
 
     std::reverse(path.begin(), path.end());
     return path;
-}
-
-void SIPP::Clear(void)
-{
-    for(auto& [state, vertex]: table)
-        delete(vertex);
-
-    table.clear();
 }
\ No newline at end of file
@@ -7,11 +7,14 @@
 #include "Types.h"
 #include "State.h"
 #include "SafeIntervals.h"
+#include "StateTable.h"
 #include <boost/heap/fibonacci_heap.hpp>
 #include <boost/unordered_map.hpp>
 #include <vector>
 #include "ILowLevelPlanner.h"
 
+class ConflictAvoidanceTable;
+
 class SIPP: public ILowLevelPlanner
 {
 public:
@@ -19,6 +22,8 @@ public:
     std::tuple<Path, unsigned long> Search(const Graph& g, const Agent& a, SafeIntervals& si) override; 
     inline void Init(IPolicy* policy, const InformedHeuristic& ih) override{this->ih = &ih; nexpansions = 0;}
     inline std::string GetName(void) const override {return "SIPP";}
+    inline ILowLevelPlanner* Clone(void) const override {return new SIPP();}
+    inline void SetConflictAvoidanceTable(const ConflictAvoidanceTable* cat) override {this->cat = cat;}
 
 protected:
     struct Vertex;
@@ -26,7 +31,7 @@ protected:
 
     using MinFibHeap = boost::heap::fibonacci_heap<Vertex*, boost::heap::compare<VertexComparator>>;
     using Successors = std::vector<Vertex*>;
-    using LookupTable = boost::unordered::unordered_map<State, Vertex*, State::Hasher, State::Equal>;
+    using LookupTable = StateTable<Vertex>;
     
     struct Vertex
     {
@@ -34,6 +39,7 @@ protected:
         State s{};
         float g = INF;
         float h = 0;
+        int nconflicts = 0; // collisions with the paths of the conflict-avoidance table along the path to this node
         bool in_open = false;
         MinFibHeap::handle_type handler;
         
@@ -44,15 +50,17 @@ protected:
 
     LookupTable table;
     const InformedHeuristic* ih = nullptr;
+    const ConflictAvoidanceTable* cat = nullptr;
     unsigned long nexpansions = 0;
 
-    Vertex* Init(const Agent& a, SafeIntervals& si);
+    Vertex* Init(const Graph& g, const Agent& a, SafeIntervals& si);
+    Vertex* BestFirstSearch(MinFibHeap& open, const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Generate(Vertex* parent, const Coordinate& successor_coordinate, const Graph& g, const Agent& a, SafeIntervals& si);
     Successors Expand(Vertex* current, const Graph& g, const Agent& a, SafeIntervals& si);
     float EarliestArrivingTime(const Vertex* parent, const State& successor_state, const Graph& g);
-    void Clear(void);
-    bool IsGenerated(const State& s) const;
     bool IsTransitionAllowed(const Vertex* parent, const State& successor_state, float arriving_time);
+    bool IsGoal(const Vertex* v, const Agent& a) const;
+    int CollisionsOf(const Vertex* parent, const Vertex* successor, float arriving_time, const Graph& g, const Agent& a) const;
     int WaitingTimeAtParent(const Vertex* parent, const Vertex* successor) const;
     Path ReconstructPath(const Vertex* goal) const;
 };
\ No newline at end of file
@@ -2,13 +2,15 @@
 #include "Constants.h"
 #include "TimeInterval.h"
 #include "Types.h"
+#include <algorithm>
+#include <climits>
 #include <sstream>
 #include <cassert>
 #include <utility>
 
-SafeIntervals::SafeIntervals(const SafeIntervals& other): configurations(other.configurations){}
+SafeIntervals::SafeIntervals(const SafeIntervals& other): configurations(other.configurations), min_length(other.min_length){}
 
-SafeIntervals::SafeIntervals(SafeIntervals&& other): configurations(std::forward<Configurations>(other.configurations)){}
+SafeIntervals::SafeIntervals(SafeIntervals&& other): configurations(std::forward<Configurations>(other.configurations)), min_length(other.min_length){}
 
 SafeIntervals::SafeIntervals(const Paths& ps): configurations()
 {
@@ -27,11 +29,19 @@ SafeIntervals::SafeIntervals(const Constraints& cs, const int constrained_agent_
     {
         if(c.constrained_agent == constrained_agent_index)
         {
-            Add(c.c, c.timestep);
+            Add(c);
         }
     }
 }
 
+SafeIntervals::SafeIntervals(const ConstraintChain* chain)
+{
+    for(; chain; chain = chain->parent.get())
+    {
+        Add(chain->c);
+    }
+}
+
 std::tuple<TimeInterval, TimeInterval> SafeIntervals::Add(const Coordinate& c, float collision_time)
 {
     auto& intervals = _IntervalsOf(c);
@@ -48,31 +58,134 @@ std::tuple<TimeInterval, TimeInterval> SafeIntervals::Add(const Coordinate& c, f
     {
         float start = iter->start, end = iter->end;
         intervals.erase(iter);
-        return _Add(intervals, start, collision_time, end);
+        auto&& split = _Add(intervals, start, collision_time, end);
+
+        // an empty set stands for a coordinate which was never constrained, hence a coordinate with no safe interval left keeps an empty one
+        if(intervals.empty())
+            intervals.insert(TimeInterval::CreateEmptyInterval());
+        return split;
     }
 
     return {TimeInterval::CreateEmptyInterval(), TimeInterval::CreateEmptyInterval()};
 }
 
+void SafeIntervals::Add(const Coordinate& c, const float start, const float end)
+{
+    auto& intervals = _IntervalsOf(c);
+    assert(!intervals.empty());
+
+    auto iter = intervals.begin();
+    while(iter != intervals.end() && iter->start < end)
+    {
+        if(iter->start < iter->end && iter->end > start) // a proper interval which overlaps [start, end)
+        {
+            const float s = iter->start, e = iter->end;
+            iter = intervals.erase(iter);
+
+            if(s < start)
+                intervals.insert({s, start});
+            if(end < e)
+                intervals.insert({end, e});
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    if(intervals.empty())
+        intervals.insert(TimeInterval::CreateEmptyInterval());
+}
+
 void SafeIntervals::Add(const Path& p)
 {
-    const int n = p.size();
+    Add(SegmentedPath(p));
+}
+
+void SafeIntervals::Add(const SegmentedPath& p)
+{
+    const auto& segments = p.GetSegments();
+    const int m = segments.size();
+    const int n = p.Length();
 
-    for(auto t = 0; t < n; t++)
+    for(int i = 0; i < m; i++)
     {
-        Add(p[t], t); // avoid vertex conflict
-        if(t > 0)
-            Add(p[t - 1], t); // avoid edge conflict
+        const auto& s = segments[i];
+        // avoid vertex conflicts while staying at s.c, and edge conflict on the timestep it is left
+        Add(s.c, s.arrival, (i + 1 < m) ? s.Departure() + 1 : s.Departure());
     }
 
     if(n > 0)
     {
-        // avoid target conflicts
-        auto& intervals = _IntervalsOf(p.back());
-        auto last_interval = *intervals.rbegin();
-        last_interval.end = n; // allow traverse agent goal until he reached it
-        intervals.erase(std::prev(intervals.end()));
-        intervals.insert(last_interval);
+        // avoid target conflicts, allow traverse agent goal until he reached it. The goal may be safe again after other paths pass through it,
+        // since the paths are not necessarily conflict-free among themselves (PBS), hence every later interval is dropped
+        auto& intervals = _IntervalsOf(p.Back());
+        auto iter = intervals.begin();
+        while(iter != intervals.end() && iter->start < n)
+        {
+            ++iter;
+        }
+        intervals.erase(iter, intervals.end());
+        intervals.insert({(float)n, (float)n});
+    }
+}
+
+void SafeIntervals::Add(const Constraint& c)
+{
+    switch(c.kind)
+    {
+        case Constraint::Kind::Vertex:
+            Add(c.c, c.timestep);
+            break;
+        case Constraint::Kind::Range:
+            Add(c.c, c.timestep, c.end == INT_MAX ? INF : c.end + 1);
+            break;
+        case Constraint::Kind::Barrier:
+        {
+            // along a row or a column, a timestep per coordinate
+            const Coordinate step{(c.last.row > c.c.row) - (c.last.row < c.c.row), (c.last.column > c.c.column) - (c.last.column < c.c.column)};
+            Coordinate v = c.c;
+            for(int t = c.timestep; ; t++)
+            {
+                Add(v, t);
+                if(v == c.last)
+                    break;
+                v = {v.row + step.row, v.column + step.column};
+            }
+            break;
+        }
+        case Constraint::Kind::Length:
+            if(c.timestep + 1 > min_length)
+            {
+                Hold(c.c, c.timestep + 1);
+            }
+            break;
+    }
+}
+
+void SafeIntervals::Hold(const Coordinate& goal, const int length)
+{
+    auto& intervals = _IntervalsOf(goal);
+
+    // the split of a weaker length constraint is lifted first
+    auto last = std::prev(intervals.end());
+    if(min_length > 0 && last != intervals.begin() && last->start == min_length && last->end == INF && std::prev(last)->end == min_length)
+    {
+        const float start = std::prev(last)->start;
+        intervals.erase(std::prev(last), intervals.end());
+        intervals.insert({start, INF});
+    }
+    min_length = length;
+
+    // the unbounded interval of the goal is split at length. Planners never wait from an interval into the next one of the same coordinate,
+    // hence the goal is held only after it is entered at length or later
+    last = std::prev(intervals.end());
+    if(last->end == INF && last->start < length)
+    {
+        const float start = last->start;
+        intervals.erase(last);
+        intervals.insert({start, (float)length});
+        intervals.insert({(float)length, INF});
     }
 }
 
@@ -137,6 +250,7 @@ SafeIntervals& SafeIntervals::operator = (SafeIntervals&& other)
     if(this != &other)
     {
         configurations = std::forward<Configurations>(other.configurations);
+        min_length = other.min_length;
     }
     return *this;
 }
@@ -146,6 +260,7 @@ SafeIntervals& SafeIntervals::operator = (const SafeIntervals& other)
     if(this != &other)
     {
         configurations =other.configurations;
+        min_length = other.min_length;
     }
     return *this;
 }
@@ -3,6 +3,8 @@
 #include "TimeInterval.h"
 #include "Types.h"
 #include "Coordinate.h"
+#include "SegmentedPath.h"
+#include "ConstraintChain.h"
 #include <string>
 #include <boost/unordered_map.hpp>
 
@@ -14,10 +16,15 @@ public:
     SafeIntervals(SafeIntervals&& other);
     SafeIntervals(const Paths& ps);
     SafeIntervals(const Constraints& cs, int constrained_agent_index);
+    SafeIntervals(const ConstraintChain* chain); // constraints imposed on a single agent
     virtual ~SafeIntervals() = default;
 
     std::tuple<TimeInterval, TimeInterval> Add(const Coordinate& c, float collision_time);
+    void Add(const Coordinate& c, float start, float end); // c is occupied during [start, end)
     void Add(const Path& p);
+    void Add(const SegmentedPath& p);
+    void Add(const Constraint& c); // constraints over many timesteps or coordinates are consumed in bulk
+    inline int GetMinimalLength(void) const {return min_length;}
     const Intervals& IntervalsOf(const Coordinate&);
     TimeInterval FirstSafeInterval(const Coordinate& c, float collision_time);
     std::string ToString(void) const;
@@ -28,7 +35,9 @@ public:
     
 protected:
     Configurations configurations;
+    int min_length = 0; // no path may reach its goal for the last time before it
 
     Intervals& _IntervalsOf(const Coordinate&);
+    void Hold(const Coordinate& goal, int length); // the goal may be held from length on only
     std::tuple<TimeInterval, TimeInterval>  _Add(Intervals& intervals, float start, float collision_time, float end);
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "SegmentedPath.h"
+#include <algorithm>
+
+bool Segment::operator == (const Segment& other) const noexcept
+{
+    return c == other.c && arrival == other.arrival && duration == other.duration;
+}
+
+SegmentedPath::Iterator::Iterator(const Segments* segments, const size_t segment, const int timestep): segments(segments), segment(segment), timestep(timestep){}
+
+SegmentedPath::Iterator& SegmentedPath::Iterator::operator ++ ()
+{
+    timestep += 1;
+    if(timestep >= (*segments)[segment].Departure())
+        segment += 1;
+
+    return *this;
+}
+
+SegmentedPath::Iterator SegmentedPath::Iterator::operator ++ (int)
+{
+    auto out = *this;
+    ++(*this);
+    return out;
+}
+
+SegmentedPath::SegmentedPath(const PathView p): segments()
+{
+    for(const auto& c: p)
+    {
+        PushBack(c);
+    }
+}
+
+SegmentedPath::SegmentedPath(Segments&& segments): segments(std::move(segments)){}
+
+void SegmentedPath::PushBack(const Coordinate& c, const int duration)
+{
+    if(!segments.empty() && segments.back().c == c)
+        segments.back().duration += duration; // wait
+    else
+        segments.push_back({c, Length(), duration});
+}
+
+Coordinate SegmentedPath::At(const int timestep) const
+{
+    if(timestep >= Length())
+        return segments.back().c;
+
+    // last segment arriving no later than timestep
+    auto iter = std::upper_bound(segments.begin(), segments.end(), timestep, [](const int t, const Segment& s){return t < s.arrival;});
+    return std::prev(iter)->c;
+}
+
+Path SegmentedPath::Expand(void) const
+{
+    Path p;
+    p.reserve(Length());
+    p.insert(p.end(), begin(), end());
+    return p;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Coordinate.h"
+#include "Types.h"
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// Maximal run of consecutive timesteps spent at the same coordinate
+struct Segment
+{
+    Coordinate c;
+    int arrival = 0;  // first timestep at c
+    int duration = 1; // number of timesteps spent at c
+
+    inline int Departure(void) const {return arrival + duration;} // first timestep after leaving c
+    bool operator == (const Segment& other) const noexcept;
+};
+
+using Segments = std::vector<Segment>;
+
+// Run-length encoded path, waiting is stored as the duration of a segment rather than as repeated coordinates.
+// Timestep t of the path corresponds to index t of the equivalent Path.
+class SegmentedPath
+{
+public:
+    // forward iterator over the coordinates of the path, one per timestep, expanded lazily
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Coordinate;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Coordinate*;
+        using reference = const Coordinate&;
+
+        Iterator() = default;
+        Iterator(const Segments* segments, size_t segment, int timestep);
+
+        inline reference operator * () const {return (*segments)[segment].c;}
+        inline pointer operator -> () const {return &(*segments)[segment].c;}
+        Iterator& operator ++ ();
+        Iterator operator ++ (int);
+        inline bool operator == (const Iterator& other) const noexcept {return segment == other.segment && timestep == other.timestep;}
+        inline bool operator != (const Iterator& other) const noexcept {return !(*this == other);}
+        inline int Timestep(void) const {return timestep;}
+
+    private:
+        const Segments* segments = nullptr;
+        size_t segment = 0;
+        int timestep = 0;
+    };
+
+    SegmentedPath() = default;
+    SegmentedPath(PathView p);
+    SegmentedPath(Segments&& segments);
+
+    void PushBack(const Coordinate& c, int duration=1);
+    Coordinate At(int timestep) const; // agent stays at the last coordinate once the path ends
+    Path Expand(void) const;
+
+    inline int Length(void) const {return segments.empty() ? 0 : segments.back().Departure();} // equals to the size of the equivalent Path
+    inline bool IsEmpty(void) const {return segments.empty();}
+    inline const Coordinate& Back(void) const {return segments.back().c;}
+    inline const Segments& GetSegments(void) const {return segments;}
+
+    inline Iterator begin(void) const {return Iterator(&segments, 0, 0);}
+    inline Iterator end(void) const {return Iterator(&segments, segments.size(), Length());}
+
+private:
+    Segments segments;
+};
+
+using SegmentedPaths = std::vector<SegmentedPath>;
+using SharedSegmentedPath = std::shared_ptr<const SegmentedPath>; // immutable path, shared by all CT nodes which do not replan its agent
+using SharedSegmentedPaths = std::vector<SharedSegmentedPath>;
\ No newline at end of file
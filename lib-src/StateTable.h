@@ -0,0 +1,90 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+// Lookup table of search vertices keyed by <vertex index, safe interval ordinal>.
+// Vertex index is given by Graph::IndexOf, interval ordinal is the position of the safe interval in SafeIntervals::IntervalsOf.
+// Entries are invalidated by bumping a generation counter, hence no clearing is needed between consecutive searches.
+// Vertices are drawn from a pool owned by the table and recycled by the next search.
+template<typename Vertex>
+class StateTable
+{
+public:
+    StateTable() = default;
+    StateTable(const StateTable&) = delete;
+    StateTable& operator = (const StateTable&) = delete;
+
+    // invalidate all entries, must be called before each search
+    void Reset(const int number_of_indices)
+    {
+        if(++generation == 0) // wrap around: stale entries may match the new generation
+        {
+            for(auto& slot: slots)
+                slot.generation = 0;
+            generation = 1;
+        }
+
+        if((int)slots.size() < number_of_indices)
+            slots.resize(number_of_indices);
+
+        used = 0;
+    }
+
+    Vertex* Find(const int index, const int ordinal) const
+    {
+        const auto& slot = slots[index];
+        return (slot.generation == generation && ordinal < (int)slot.vertices.size()) ? slot.vertices[ordinal] : nullptr;
+    }
+
+    // return a default-initialized vertex registered under <index, ordinal>
+    Vertex* Create(const int index, const int ordinal)
+    {
+        auto& slot = slots[index];
+        if(slot.generation != generation)
+        {
+            slot.vertices.clear();
+            slot.generation = generation;
+        }
+
+        if((int)slot.vertices.size() <= ordinal)
+            slot.vertices.resize(ordinal + 1, nullptr);
+
+        slot.vertices[ordinal] = Allocate();
+        return slot.vertices[ordinal];
+    }
+
+    // vertices of all safe intervals of the given index, ordered by ordinal (may contain nullptr)
+    const std::vector<Vertex*>& VerticesOf(const int index) const
+    {
+        static const std::vector<Vertex*> none;
+        const auto& slot = slots[index];
+        return slot.generation == generation ? slot.vertices : none;
+    }
+
+    // i-th vertex created since the last reset
+    inline Vertex* At(const size_t i) {return &pool[i];}
+    inline size_t Size(void) const {return used;}
+
+private:
+    struct Slot
+    {
+        unsigned generation = 0;
+        std::vector<Vertex*> vertices; // vertices[ordinal] := vertex of the ordinal-th safe interval
+    };
+
+    std::vector<Slot> slots;
+    std::deque<Vertex> pool; // deque keeps addresses stable when growing
+    size_t used = 0;
+    unsigned generation = 0;
+
+    Vertex* Allocate(void)
+    {
+        if(used == pool.size())
+            pool.emplace_back();
+        else
+            pool[used] = Vertex(); // rather than Vertex{}, which copy-list-initializes the heap handles through their explicit constructor
+
+        return &pool[used++];
+    }
+};
\ No newline at end of file
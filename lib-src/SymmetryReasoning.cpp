@@ -0,0 +1,240 @@
+#include "SymmetryReasoning.h"
+#include "CorridorConflict.h"
+#include "EdgeConflict.h"
+#include "RectangleConflict.h"
+#include "TargetConflict.h"
+#include "VertexConflict.h"
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
+#include <deque>
+#include <optional>
+#include <utility>
+
+IConflict* SymmetryReasoning::Target(const IConflict* conflict, const SharedSegmentedPaths& ps)
+{
+    const auto vertex = dynamic_cast<const VertexConflict*>(conflict);
+    if(!vertex)
+        return nullptr;
+
+    // either the resting agent finishes later, or the other agent avoids its goal from then on
+    for(int k = 0; k < 2; k++)
+    {
+        const auto& p = *ps[conflict->agents_indices[k]];
+        if(p.Back() == vertex->c && conflict->timestep >= p.Length() - 1)
+        {
+            return new TargetConflict({conflict->agents_indices[k], conflict->agents_indices[1 - k]}, conflict->timestep, vertex->c);
+        }
+    }
+
+    return nullptr;
+}
+
+IConflict* SymmetryReasoning::Corridor(const IConflict* conflict, const SharedSegmentedPaths& ps, const Graph& g, const Agents& as)
+{
+    Coordinate v;
+    if(const auto vertex = dynamic_cast<const VertexConflict*>(conflict))
+        v = vertex->c;
+    else if(const auto edge = dynamic_cast<const EdgeConflict*>(conflict))
+        v = edge->e1.destination;
+    else
+        return nullptr;
+
+    if(DegreeOf(g, v) != 2)
+        return nullptr;
+
+    // walk from v both ways, until a vertex of a higher degree ends the corridor
+    std::vector<bool> is_inside(g.GetNumberOfIndices(), false);
+    std::array<Coordinate, 2> ends;
+    std::vector<Coordinate> neighbors;
+    int length = 2; // edges between the ends
+
+    is_inside[g.IndexOf(v)] = true;
+    for(const auto& u: g.AdjacentOf(v))
+    {
+        if(u != v)
+            neighbors.push_back(u);
+    }
+
+    for(int k = 0; k < 2; k++)
+    {
+        Coordinate previous = v, current = neighbors[k];
+        while(DegreeOf(g, current) == 2 && !is_inside[g.IndexOf(current)])
+        {
+            is_inside[g.IndexOf(current)] = true;
+            length += 1;
+            for(const auto& u: g.AdjacentOf(current))
+            {
+                if(u != current && u != previous)
+                {
+                    previous = std::exchange(current, u);
+                    break;
+                }
+            }
+        }
+
+        if(is_inside[g.IndexOf(current)] || DegreeOf(g, current) < 3)
+            return nullptr; // a cycle, or a dead end which no agent traverses
+        ends[k] = current;
+    }
+
+    if(ends[0] == ends[1])
+        return nullptr;
+
+    // the ends each agent enters and leaves the corridor through, around the conflict, and its arrival at the latter
+    struct Traversal{Coordinate entry, exit; int arrival;};
+    const auto traversal_of = [&](const int agent_index) -> std::optional<Traversal>
+    {
+        const auto& p = *ps[agent_index];
+        const int t = is_inside[g.IndexOf(p.At(conflict->timestep))] ? conflict->timestep : conflict->timestep - 1;
+        if(t < 0 || !is_inside[g.IndexOf(p.At(t))] || is_inside[g.IndexOf(as[agent_index].start)])
+            return std::nullopt;
+
+        int from = t, to = t;
+        while(from >= 0 && is_inside[g.IndexOf(p.At(from))])
+            from--;
+        while(to < p.Length() && is_inside[g.IndexOf(p.At(to))])
+            to++;
+
+        if(from < 0 || to == p.Length() || p.At(from) == p.At(to))
+            return std::nullopt; // the agent rests inside the corridor, or turns back
+        return Traversal{p.At(from), p.At(to), to};
+    };
+
+    const int a = conflict->agents_indices[0], b = conflict->agents_indices[1];
+    const auto ta = traversal_of(a), tb = traversal_of(b);
+    if(!ta || !tb || ta->entry != tb->exit || ta->exit != tb->entry)
+        return nullptr;
+
+    // an agent leaves through its exit no earlier than the other agent clears the corridor, unless it bypasses the corridor altogether
+    const std::vector<bool> none(g.GetNumberOfIndices(), false);
+    const int shortest_a = DistanceOf(g, as[a].start, ta->exit, none), shortest_b = DistanceOf(g, as[b].start, tb->exit, none);
+    const int bypass_a = DistanceOf(g, as[a].start, ta->exit, is_inside), bypass_b = DistanceOf(g, as[b].start, tb->exit, is_inside);
+    if(shortest_a == INT_MAX || shortest_b == INT_MAX)
+        return nullptr;
+
+    const int latest_a = std::min(bypass_a - 1, shortest_b + length), latest_b = std::min(bypass_b - 1, shortest_a + length);
+    if(ta->arrival > latest_a || tb->arrival > latest_b)
+        return nullptr; // a constraint the current path already satisfies resolves nothing
+
+    return new CorridorConflict({a, b}, conflict->timestep, {ta->exit, tb->exit}, {latest_a, latest_b});
+}
+
+IConflict* SymmetryReasoning::Rectangle(const IConflict* conflict, const SharedSegmentedPaths& ps)
+{
+    const auto vertex = dynamic_cast<const VertexConflict*>(conflict);
+    if(!vertex)
+        return nullptr;
+
+    // the prefix of each path which moves away from its start at every timestep, through the conflict
+    const int t = conflict->timestep;
+    std::array<Coordinate, 2> starts, goals;
+    for(int k = 0; k < 2; k++)
+    {
+        const auto& p = *ps[conflict->agents_indices[k]];
+        starts[k] = p.At(0);
+        if(ManhattanDistance(vertex->c, starts[k]) != t)
+            return nullptr;
+
+        int last = t;
+        while(last + 1 < p.Length() && ManhattanDistance(p.At(last + 1), starts[k]) == last + 1)
+            last++;
+        goals[k] = p.At(last);
+    }
+
+    const auto sign = [](const int x){return (x > 0) - (x < 0);};
+    int drow = 0, dcolumn = 0;
+    for(int k = 0; k < 2; k++)
+    {
+        const int r = sign(goals[k].row - starts[k].row), c = sign(goals[k].column - starts[k].column);
+        if(r * drow < 0 || c * dcolumn < 0)
+            return nullptr; // the agents move apart along an axis
+        drow = drow ? drow : r;
+        dcolumn = dcolumn ? dcolumn : c;
+    }
+    if(!drow || !dcolumn)
+        return nullptr;
+
+    // mirror the grid so that both agents move towards increasing x and y
+    const auto mirror = [drow, dcolumn](const Coordinate& c){return Coordinate(drow * c.row, dcolumn * c.column);};
+    const auto x = [&mirror](const Coordinate& c){return mirror(c).column;};
+    const auto y = [&mirror](const Coordinate& c){return mirror(c).row;};
+    const auto at = [&mirror](const int x, const int y){return mirror(Coordinate(y, x));};
+
+    // h crosses the rectangle from its left side to its right one, w from its bottom side to its top one
+    for(const auto& [h, w]: {std::pair{0, 1}, std::pair{1, 0}})
+    {
+        if(x(starts[h]) > x(starts[w]) || y(starts[h]) < y(starts[w]) || x(goals[h]) < x(goals[w]) || y(goals[h]) > y(goals[w]))
+            continue;
+
+        const int left = x(starts[w]), bottom = y(starts[h]), right = x(goals[w]), top = y(goals[h]);
+        if(left > right || bottom > top || (left == right && bottom == top))
+            continue;
+
+        const std::array<Coordinate, 2> firsts{at(right, bottom), at(left, top)}, lasts{at(right, top), at(right, top)};
+        const std::array<int, 2> timesteps{right - x(starts[h]), top - y(starts[w])};
+        const std::array<int, 2> agents{conflict->agents_indices[h], conflict->agents_indices[w]};
+
+        // each path crosses its barrier, at the timestep the barrier forbids
+        const auto violates = [&](const int k)
+        {
+            const auto& p = *ps[agents[k]];
+            const int n = ManhattanDistance(firsts[k], lasts[k]);
+            const int dr = sign(lasts[k].row - firsts[k].row), dc = sign(lasts[k].column - firsts[k].column);
+            for(int i = 0; i <= n; i++)
+            {
+                if(p.At(timesteps[k] + i) == Coordinate(firsts[k].row + i * dr, firsts[k].column + i * dc))
+                    return true;
+            }
+            return false;
+        };
+
+        if(violates(0) && violates(1))
+        {
+            return new RectangleConflict({agents[0], agents[1]}, t, firsts, lasts, timesteps);
+        }
+    }
+
+    return nullptr;
+}
+
+int SymmetryReasoning::DegreeOf(const Graph& g, const Coordinate& c)
+{
+    auto successors = g.AdjacentOf(c), predecessors = g.PredecessorsOf(c);
+    successors.erase(c);
+    predecessors.erase(c);
+    return successors == predecessors ? (int)successors.size() : -1;
+}
+
+int SymmetryReasoning::DistanceOf(const Graph& g, const Coordinate& from, const Coordinate& to, const std::vector<bool>& is_blocked)
+{
+    std::vector<int> distance(g.GetNumberOfIndices(), INT_MAX);
+    std::deque<Coordinate> q{from};
+    distance[g.IndexOf(from)] = 0;
+
+    while(!q.empty())
+    {
+        const auto u = q.front();
+        q.pop_front();
+        if(u == to)
+            return distance[g.IndexOf(u)];
+
+        for(const auto& v: g.AdjacentOf(u))
+        {
+            const int i = g.IndexOf(v);
+            if(distance[i] == INT_MAX && !is_blocked[i])
+            {
+                distance[i] = distance[g.IndexOf(u)] + 1;
+                q.push_back(v);
+            }
+        }
+    }
+
+    return INT_MAX;
+}
+
+int SymmetryReasoning::ManhattanDistance(const Coordinate& c1, const Coordinate& c2)
+{
+    return std::abs(c1.row - c2.row) + std::abs(c1.column - c2.column);
+}
\ No newline at end of file
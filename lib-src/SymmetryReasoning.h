@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Graph.h"
+#include "IConflict.h"
+#include "SegmentedPath.h"
+#include "Types.h"
+#include <vector>
+
+// Recognizes conflicts which CBS resolves by vertex constraints only after exponentially many CT nodes, from the paths of the conflicting agents.
+// Each reasoning returns a conflict whose constraints span many timesteps or coordinates at once, or nullptr if the pattern is not found.
+// The path of each agent violates the constraint imposed on it, and no pair of non-conflicting paths violates both, hence CBS stays optimal.
+// Stateless, hence safe to call concurrently.
+class SymmetryReasoning
+{
+public:
+    // an agent which already rests at its goal, where the other agent arrives later
+    static IConflict* Target(const IConflict* conflict, const SharedSegmentedPaths& ps);
+    // agents which traverse a corridor, a chain of vertices of degree 2, in opposite directions
+    static IConflict* Corridor(const IConflict* conflict, const SharedSegmentedPaths& ps, const Graph& g, const Agents& as);
+    // agents which move along shortest paths in the same directions, across a rectangle of equally short paths. 4-connected grids only
+    static IConflict* Rectangle(const IConflict* conflict, const SharedSegmentedPaths& ps);
+
+protected:
+    static int DegreeOf(const Graph& g, const Coordinate& c); // number of neighbors, -1 if c is entered and left through different neighbors
+    static int DistanceOf(const Graph& g, const Coordinate& from, const Coordinate& to, const std::vector<bool>& is_blocked); // INT_MAX if unreachable
+    static int ManhattanDistance(const Coordinate& c1, const Coordinate& c2);
+};
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "TargetConflict.h"
+#include <cassert>
+#include <climits>
+#include <sstream>
+
+TargetConflict::TargetConflict(const std::vector<int>& agents_indices, const int timestep, const Coordinate& goal): IConflict(agents_indices, timestep), goal(goal){}
+
+std::string TargetConflict::ToString(void) const
+{
+    std::stringstream ss;
+    ss << "Target-Conflict on: " << goal << ", at: " << timestep << ". Agent" << agents_indices[1] << " visits the goal of Agent" << agents_indices[0] << '.';
+    return ss.str();
+}
+
+std::vector<Constraint> TargetConflict::Resolve(void) const
+{
+    assert(agents_indices.size() == 2);
+    return {Constraint::Length(agents_indices[0], agents_indices[1], goal, timestep), Constraint::Range(agents_indices[1], agents_indices[0], goal, timestep, INT_MAX)};
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "IConflict.h"
+#include "Coordinate.h"
+
+// agents_indices[1] visits the goal of agents_indices[0] after the path of the latter ended there. Either that path ends later,
+// or the goal is never visited again from the timestep of the conflict on
+struct TargetConflict: public IConflict
+{
+    const Coordinate goal;
+
+    TargetConflict(const std::vector<int>& agents_indices, int timestep, const Coordinate& goal);
+    virtual ~TargetConflict() = default;
+
+    std::string ToString(void) const override;
+    std::vector<Constraint> Resolve(void) const override;
+};
\ No newline at end of file
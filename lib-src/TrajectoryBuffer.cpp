@@ -0,0 +1,42 @@
+#include "TrajectoryBuffer.h"
+#include "PlanBuffer.h"
+
+TrajectoryBuffer::TrajectoryBuffer(const int number_of_agents, const int chunk_length): number_of_agents(number_of_agents), chunk_length(chunk_length), chunks()
+{
+    chunks.emplace_back(chunk_length * number_of_agents);
+}
+
+void TrajectoryBuffer::Record(const PlanBuffer& planned)
+{
+    if(length == (int)chunks.size() * chunk_length)
+        chunks.emplace_back(chunk_length * number_of_agents);
+
+    auto& chunk = chunks[length / chunk_length];
+    const int offset = (length % chunk_length) * number_of_agents;
+
+    for(int i = 0; i < number_of_agents; i++)
+    {
+        chunk[offset + i] = planned.CurrentOf(i);
+    }
+
+    length += 1;
+}
+
+const Coordinate& TrajectoryBuffer::At(const int agent_index, const int timestep) const
+{
+    return chunks[timestep / chunk_length][(timestep % chunk_length) * number_of_agents + agent_index];
+}
+
+Paths TrajectoryBuffer::ToPaths(void) const
+{
+    Paths ps(number_of_agents);
+
+    for(int i = 0; i < number_of_agents; i++)
+    {
+        ps[i].reserve(length);
+        for(int t = 0; t < length; t++)
+            ps[i].push_back(At(i, t));
+    }
+
+    return ps;
+}
\ No newline at end of file
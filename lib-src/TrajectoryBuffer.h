@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Coordinate.h"
+#include "Types.h"
+#include <vector>
+
+class PlanBuffer;
+
+// Realized trajectories of all agents, recorded timestep by timestep into preallocated chunks.
+// A chunk holds the coordinates of all agents over a fixed number of timesteps, hence recording never relocates earlier timesteps.
+class TrajectoryBuffer
+{
+public:
+    TrajectoryBuffer(int number_of_agents, int chunk_length=64);
+
+    void Record(const PlanBuffer& planned); // append the current coordinate of each agent
+    const Coordinate& At(int agent_index, int timestep) const;
+    inline const Coordinate& Back(int agent_index) const {return At(agent_index, length - 1);}
+    inline int Length(void) const {return length;}
+    inline int GetNumberOfAgents(void) const {return number_of_agents;}
+    Paths ToPaths(void) const;
+
+private:
+    int number_of_agents;
+    int chunk_length;
+    int length = 0;
+    std::vector<std::vector<Coordinate>> chunks; // chunks[j][(t - j * chunk_length) * number_of_agents + i] := coordinate of agent i at timestep t
+};
\ No newline at end of file
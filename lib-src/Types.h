@@ -6,6 +6,7 @@
 #include <tuple>
 #include <vector>
 #include <set>
+#include <span>
 #include "Agent.h"
 #include "Coordinate.h"
 #include "Edge.h"
@@ -25,6 +26,8 @@ using GridRow = std::vector<Terrain>;
 using Grid = std::vector<GridRow>;
 using Path = std::vector<Coordinate>;
 using Paths = std::vector<Path>;
+using PathView = std::span<const Coordinate>;
+using PathViews = std::vector<PathView>;
 using NeighborhoodFunction = CoordinateSet(*)(const Coordinate& c, size_t R);
 using HeuristicFunction = float(*)(const Coordinate& c1, const Coordinate& c2);
 using AdjacencyList = boost::unordered::unordered_map<Coordinate, CoordinateSet, Coordinate::Hasher, Coordinate::Equal>;
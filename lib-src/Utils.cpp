@@ -8,6 +8,7 @@
 #include "EdgeConflict.h"
 #include <algorithm>
 #include <cstdlib>
+#include <map>
 #include "Astar.h"
 
 CoordinateSet Neighborhood::FourPrincipleDirection(const Coordinate& c, size_t R)
@@ -82,26 +83,116 @@ long ObjectiveFunction::Makespan(const Paths& ps)
 
 Conflicts Validator::FindConflicts(const Paths& ps)
 {
-    Conflicts conflicts;
-    CoordinateMap cmap;
-    EdgeMap emap;
+    SegmentedPaths segmented_paths;
+    segmented_paths.reserve(ps.size());
+
+    for(const auto& p: ps)
+    {
+        segmented_paths.emplace_back(p);
+    }
+
+    return FindConflicts(segmented_paths);
+}
+
+Conflicts Validator::FindConflicts(const PathViews& ps)
+{
+    SegmentedPaths segmented_paths;
+    segmented_paths.reserve(ps.size());
+
+    for(const auto& p: ps)
+    {
+        segmented_paths.emplace_back(p);
+    }
 
-    const auto max_time_step = ObjectiveFunction::Makespan(ps);
-    const auto number_of_agents = ps.size();
+    return FindConflicts(segmented_paths);
+}
+
+Conflicts Validator::FindConflicts(const SegmentedPaths& ps)
+{
+    using Occupancy = std::tuple<int, int, int>; // <arrival, departure, agent index>
+    boost::unordered_map<Coordinate, std::vector<Occupancy>, Coordinate::Hasher, Coordinate::Equal> occupancies;
+    std::map<int, std::vector<std::tuple<Edge, int>>> moves; // departure timestep -> <traversed edge, agent index>
+    std::vector<std::tuple<int, int, IConflict*>> found; // <scanned timestep, vertex (0) or edge (1) conflict, conflict>
+
+    int makespan = 0;
+    for(const auto& p: ps)
+    {
+        if(!p.IsEmpty())
+            makespan = std::max(makespan, p.Length() - 1);
+    }
 
-    for(size_t timestep = 0; timestep <= max_time_step; timestep++)
+    const int number_of_agents = ps.size();
+    for(int i = 0; i < number_of_agents; i++)
     {
-        for(size_t i = 0; i < number_of_agents; i++)
+        const auto& segments = ps[i].GetSegments();
+        const int m = segments.size();
+
+        for(int j = 0; j < m; j++)
+        {
+            const auto& s = segments[j];
+            // an agent waits at its last coordinate until all agents are done
+            occupancies[s.c].emplace_back(s.arrival, (j + 1 < m) ? s.Departure() : makespan + 1, i);
+            if(j > 0)
+                moves[s.arrival - 1].emplace_back(Edge{segments[j - 1].c, s.c}, i);
+        }
+    }
+
+    // vertex conflicts: sweep the occupancies of each coordinate, the set of occupying agents changes only at arrivals and departures
+    for(const auto& [coordinate, occupancy]: occupancies)
+    {
+        if(occupancy.size() < 2)
+            continue;
+
+        std::vector<int> timesteps;
+        for(const auto& [arrival, departure, agent]: occupancy)
         {
-            const auto& p = ps.at(i);
-            if(!p.empty())
+            timesteps.push_back(arrival);
+            timesteps.push_back(departure);
+        }
+        std::sort(timesteps.begin(), timesteps.end());
+        timesteps.erase(std::unique(timesteps.begin(), timesteps.end()), timesteps.end());
+
+        for(size_t j = 0; j + 1 < timesteps.size(); j++)
+        {
+            std::vector<int> agents_indices; // ascending, as occupancies are inserted by agent index
+            for(const auto& [arrival, departure, agent]: occupancy)
             {
-                cmap[GetCoordinateAt(p, timestep)].push_back(i);
-                emap[GetEdgeAt(p, timestep)] = {i, false};
+                if(arrival <= timesteps[j] && timesteps[j] < departure)
+                    agents_indices.push_back(agent);
+            }
+
+            if(agents_indices.size() > 1)
+            {
+                for(int t = timesteps[j]; t < timesteps[j + 1]; t++)
+                    found.emplace_back(t, 0, new VertexConflict(agents_indices, t, coordinate));
             }
         }
-        AddVertexConflictsAt(conflicts, timestep, cmap);
-        AddEdgeConflictsAt(conflicts, timestep, emap);
+    }
+
+    // edge conflicts: agents move only between consecutive segments
+    EdgeMap emap;
+    for(const auto& [timestep, edges]: moves)
+    {
+        for(const auto& [edge, agent]: edges)
+            emap[edge] = {agent, false};
+
+        Conflicts edge_conflicts;
+        AddEdgeConflictsAt(edge_conflicts, timestep, emap);
+        for(auto conflict: edge_conflicts)
+            found.emplace_back(timestep, 1, conflict);
+    }
+
+    // earliest conflicts first, vertex conflicts precede edge conflicts scanned at the same timestep
+    std::stable_sort(found.begin(), found.end(), [](const auto& x, const auto& y)
+    {
+        return std::tie(std::get<0>(x), std::get<1>(x)) < std::tie(std::get<0>(y), std::get<1>(y));
+    });
+
+    Conflicts conflicts;
+    conflicts.reserve(found.size());
+    for(const auto& [timestep, type, conflict]: found)
+    {
+        conflicts.push_back(conflict);
     }
 
     return conflicts;
@@ -186,6 +277,23 @@ bool Validator::AreAllAgentsReachedTheirGoals(const Agents& as, const Paths& ps,
     return is_valid;
 }
 
+bool Validator::AreAllAgentsReachedTheirGoals(const Agents& as, const TrajectoryBuffer& realized)
+{
+    assert((int)as.size() == realized.GetNumberOfAgents());
+
+    if(realized.Length() == 0)
+        return as.empty();
+
+    const int k = as.size();
+    for(int i = 0; i < k; i++)
+    {
+        if(realized.Back(i) != as[i].goal)
+            return false;
+    }
+
+    return true;
+}
+
 bool Validator::AreAllPathsContainsOnlyValidTransitions(const Snapshot& snap, const Paths& ps, const Agents& as, const bool verbose)
 {
     auto is_path_contains_only_valid_transition = [&snap, verbose](const Path& p, const Agent& a)
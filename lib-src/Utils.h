@@ -2,6 +2,8 @@
 
 #include "Coordinate.h"
 #include "Snapshot.h"
+#include "SegmentedPath.h"
+#include "TrajectoryBuffer.h"
 #include "Types.h"
 class Map;
 
@@ -33,9 +35,12 @@ public:
     static Agents ValidAgents(const Agents& src, const Map& m);
     static bool IsLegalPlan(const Snapshot& snap, const Paths& ps, const Agents& as, bool verbose=true);
     static Conflicts FindConflicts(const Paths& paths);
+    static Conflicts FindConflicts(const PathViews& paths);
+    static Conflicts FindConflicts(const SegmentedPaths& paths);
     static bool NoConflictsExists(const Paths& ps, bool verbose=true);
     static bool ExistsConflict(const Paths& ps);
     static bool AreAllAgentsReachedTheirGoals(const Agents& as, const Paths& ps, bool verbose=false);
+    static bool AreAllAgentsReachedTheirGoals(const Agents& as, const TrajectoryBuffer& realized);
     static bool AreAllPathsContainsOnlyValidTransitions(const Snapshot& snap, const Paths& ps, const Agents&, bool verbose=true);
     static void Free(const Conflicts&);
 
@@ -0,0 +1,104 @@
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(const int nworkers)
+{
+    for(int i = 0; i < nworkers; i++)
+    {
+        queues.push_back(std::make_unique<Queue>());
+    }
+
+    for(int i = 0; i < nworkers; i++)
+    {
+        threads.emplace_back(&WorkStealingPool::Run, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard lock(m);
+        is_stopped = true;
+    }
+    cv.notify_all();
+
+    for(auto& t: threads)
+    {
+        t.join();
+    }
+}
+
+void WorkStealingPool::Submit(Task task)
+{
+    std::lock_guard lock(m);
+    auto& queue = *queues[next];
+    next = (next + 1) % queues.size();
+
+    {
+        std::lock_guard queue_lock(queue.m);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    pending += 1;
+    cv.notify_one();
+}
+
+void WorkStealingPool::Run(const int worker_index)
+{
+    Task task;
+
+    while(true)
+    {
+        {
+            std::unique_lock lock(m);
+            cv.wait(lock, [this](){return pending > 0 || is_stopped;});
+            if(is_stopped)
+                return;
+        }
+
+        if(TryTake(worker_index, task))
+        {
+            task(worker_index);
+            task = nullptr;
+        }
+    }
+}
+
+bool WorkStealingPool::TryTake(const int worker_index, Task& task)
+{
+    const int n = queues.size();
+
+    for(int k = 0; k < n; k++)
+    {
+        const int i = (worker_index + k) % n;
+        auto& queue = *queues[i];
+        bool is_taken = false;
+
+        {
+            std::lock_guard queue_lock(queue.m);
+            if(!queue.tasks.empty())
+            {
+                if(i == worker_index)
+                {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                else
+                {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    nsteals += 1;
+                }
+                is_taken = true;
+            }
+        }
+
+        if(is_taken) // m is never acquired while holding a queue lock, Submit locks them the other way around
+        {
+            std::lock_guard lock(m);
+            pending -= 1;
+            return true;
+        }
+    }
+
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each owning a deque of tasks. Tasks are dealt to the deques round-robin, a worker serves its own deque from the back
+// and, once it is empty, steals from the front of the others'.
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void(int worker_index)>;
+
+    WorkStealingPool(int nworkers);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator = (const WorkStealingPool&) = delete;
+
+    void Submit(Task task);
+    inline int GetNumberOfWorkers(void) const {return threads.size();}
+    inline unsigned long GetNumberOfSteals(void) const {return nsteals;}
+
+private:
+    struct Queue
+    {
+        std::mutex m;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex m; // guards pending and is_stopped
+    std::condition_variable cv;
+    size_t pending = 0; // number of submitted tasks not taken yet
+    bool is_stopped = false;
+    size_t next = 0; // deque the next task is dealt to
+    std::atomic<unsigned long> nsteals{0};
+
+    void Run(int worker_index);
+    bool TryTake(int worker_index, Task& task);
+};
@@ -20,10 +20,10 @@ usage() {
     echo "                                                              Options: full_planner, full_id_planner, local_planner, local_id_planner"
     echo
     echo "  -hl, --high_level_planner_name <high_level_planner_name>    High-level planner name (default: cbs)"
-    echo "                                                              Options: pp, cbs"
+    echo "                                                              Options: pp, pp_speculative, cbs, cbs_cg, cbs_dg, cbs_wdg, ecbs, ma_cbs, ma_cbs_restart, parallel_cbs, portfolio, lns, pbs, pibt, pibt_greedy"
     echo
     echo "  -ll, --low_level_planner_name <low_level_planner_name>      Low-level planner name (default: sipp)"
-    echo "                                                              Options: sipp, ees_sipp"
+    echo "                                                              Options: sipp, ees_sipp, focal_sipp, incremental_sipp"
     echo
     echo "  -p  <policy_name>                                           Policy name (default: baseline)"
     echo "                                                              Options: risk_averse, explorative, hybrid, baseline"